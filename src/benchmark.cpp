@@ -0,0 +1,59 @@
+#include "core.h"
+#include "potentials.h"
+#include "random.h"
+#include <iomanip>
+
+/*
+ * Micro benchmarks of performance critical parts. Each benchmark
+ * prints the time per evaluation for the contestants, as well as
+ * a checksum to ensure that they calculate the same thing.
+ */
+
+using namespace Faunus;
+using namespace Faunus::Potential;
+
+typedef Particle<Charge> Tparticle;
+
+template<class Tpairpot>
+void pairpot(const std::string &name, const Tpairpot &u, const std::vector<Tparticle> &p, const std::vector<Point> &r) {
+    Stopwatch w;
+    double sum=0;
+    for (size_t i=0; i<r.size(); i++)
+        sum += u( p[i % p.size()], p[(i+1) % p.size()], r[i] );
+    w.stop(false);
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(w.end-w.beg).count();
+    std::cout << "  " << std::left << std::setw(20) << name << std::setw(10) << double(ns)/r.size()
+        << " ns/pair   checksum = " << sum << std::endl;
+}
+
+int main() {
+    atoms<Tparticle> = R"([
+        {"A": {"q":  1.0, "sigma": 4.0, "eps": 0.1}},
+        {"B": {"q": -1.0, "sigma": 3.0, "eps": 0.2}},
+        {"C": {"q":  0.0, "sigma": 2.0, "eps": 0.1}}
+        ])"_json.get<decltype(atoms<Tparticle>)>();
+
+    std::vector<Tparticle> p(100);
+    for (auto &i : p)
+        i = atoms<Tparticle>[ (&i-&p[0]) % atoms<Tparticle>.size() ].p;
+
+    std::vector<Point> r(1000000);
+    for (auto &i : r)
+        i = (4 + 10*Faunus::random()) * ranunit(Faunus::random);
+
+    json j = R"({
+        "default": [
+            { "coulomb": {"epsr": 80, "type": "plain", "cutoff": 20} },
+            { "wca": {"mixing": "LB"} },
+            { "hardsphere": {} }
+        ]})"_json;
+
+    std::cout << "pair potential with three terms:" << std::endl;
+    FunctorPotential<Tparticle> functor = j;
+    SwitchPotential<Tparticle> switched = j;
+    j["cutoff"] = 15;
+    SplinedPotential<Tparticle> splined = j;
+    pairpot("FunctorPotential", functor, p, r);
+    pairpot("SwitchPotential", switched, p, r);
+    pairpot("SplinedPotential", splined, p, r);
+}
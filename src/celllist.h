@@ -2,110 +2,204 @@
 
 #include <iostream>
 #include <vector>
-#include <set>
 #include <cassert>
 #include <cmath>
 #include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
 #include <Eigen/Core>
 
 namespace Faunus {
 
     /**
-     * @brief Cuboidal cell list with periodic boundaries
+     * @brief Cuboidal cell list with optional periodic boundaries
      *
      * Maps cartesian points to a grid of arbitrary resolution that
      * stores particle index.
      *
      * - cartesian space is assume to use all 8 octants (i.e. +/i round 0,0,0)
      * - grid space use only the first octant (all +)
-     * - resolution and size is set by `resize`
+     * - resolution and size is set by `resize`; cells are never smaller than the cutoff
+     * - periodic dimensions wrap around; non-periodic dimensions are clamped to the grid
      * - index of neighbors to a grid point
-     *   is obtained with `neighbors()`
+     *   is obtained with `neighbors()` or visited with `forEachNeighbor()`
      * - index can be moved from one grid point to another with `move()`
-     * - the list of particle index in each grid point is stored in a
-     *   `std::set<int>` container.
+     * - cells are stored in flat arrays as doubly linked lists (`head`, `next`, `prev`)
+     *   so that insertion, removal and moves are constant time operations
      *
      * @date Malmo, March 2018
      */
     template<typename CellPoint=Eigen::Vector3i>
         class CellList {
             typedef Eigen::Vector3d Point;
-            Point halfbox;
-            double cellsize=0; // cell side length (angstrom)
-            std::vector<std::vector<std::vector<std::set<int>>>> cells;
+            Point halfbox, cellsize, cellsize_inv; // cell side lengths (angstrom)
+            std::array<bool,3> pbc = {{true,true,true}}; // periodic dimensions
+            std::vector<int> head; // first index in each cell (-1 if empty)
+            std::vector<int> next, prev, cell; // per index: linked list neighbors and owning cell
+            std::vector<int> nboffset, nbcells; // neighbor cells to each cell (compressed rows)
+
+            void buildNeighbors() {
+                nboffset.assign(1, 0);
+                nbcells.clear();
+                std::vector<int> tmp;
+                tmp.reserve(27);
+                for (int k=0; k<=KLM[0]; k++)
+                    for (int l=0; l<=KLM[1]; l++)
+                        for (int m=0; m<=KLM[2]; m++) {
+                            tmp.clear();
+                            for (int dk=-1; dk<=1; dk++)
+                                for (int dl=-1; dl<=1; dl++)
+                                    for (int dm=-1; dm<=1; dm++) {
+                                        CellPoint c(k+dk, l+dl, m+dm);
+                                        if (wrap(c))
+                                            tmp.push_back( index(c) );
+                                    }
+                            std::sort(tmp.begin(), tmp.end()); // small grids may see
+                            tmp.erase( std::unique(tmp.begin(), tmp.end()), tmp.end() ); // the same cell twice
+                            nbcells.insert(nbcells.end(), tmp.begin(), tmp.end());
+                            nboffset.push_back( nbcells.size() );
+                        }
+            }
+
+            bool wrap(CellPoint &c) const {
+                for (int d=0; d<3; d++) {
+                    if (c[d]<0 || c[d]>KLM[d]) {
+                        if (!pbc[d])
+                            return false;
+                        c[d] = (c[d]<0) ? c[d]+KLM[d]+1 : c[d]-KLM[d]-1;
+                    }
+                }
+                return true;
+            } //!< apply periodic boundaries to cell point; false if outside non-periodic grid
 
             public:
 
             CellPoint KLM = {0,0,0}; // max cell index K,L,M
 
-            auto& operator[](const CellPoint &c) {
-                return cells[c[0]][c[1]][c[2]];
-            } //!< returns set with all index in given cell (complexity: constant)
+            size_t size() const { return head.size(); } //!< Number of cells
+
+            int index(const CellPoint &c) const {
+                return (c[0]*(KLM[1]+1) + c[1])*(KLM[2]+1) + c[2];
+            } //!< cell point --> flat cell index
 
             CellPoint p2c(const Point &p) const {
-                return ((p+halfbox)/cellsize).array().round().template cast<int>();
+                CellPoint c = ((p+halfbox).cwiseProduct(cellsize_inv)).array().floor().template cast<int>();
+                for (int d=0; d<3; d++)
+                    if (c[d]<0 || c[d]>KLM[d]) {
+                        if (pbc[d])
+                            c[d] = ((c[d] % (KLM[d]+1)) + KLM[d]+1) % (KLM[d]+1);
+                        else
+                            c[d] = std::max(0, std::min(c[d], KLM[d]));
+                    }
+                return c;
             } //!< cartesian point --> cell point
 
             Point c2p(const CellPoint &c) const {
-                return (c.template cast<double>()) * cellsize - halfbox;
-            } //!< cell point --> cartesian point
+                return (c.template cast<double>()).cwiseProduct(cellsize) - halfbox;
+            } //!< cell point --> cartesian point (lower corner)
+
+            int cellOf(int i) const {
+                return (i>=0 && i<(int)cell.size()) ? cell[i] : -1;
+            } //!< flat cell index of particle index i; -1 if not present
+
+            void insert(int i, int c) {
+                assert(c>=0 && c<(int)size());
+                if (i>=(int)cell.size()) {
+                    cell.resize(i+1, -1);
+                    next.resize(i+1, -1);
+                    prev.resize(i+1, -1);
+                }
+                assert(cell[i]==-1 && "i already in cell list");
+                cell[i] = c;
+                prev[i] = -1;
+                next[i] = head[c];
+                if (head[c]>=0)
+                    prev[head[c]] = i;
+                head[c] = i;
+            } //!< insert particle index i in cell c (complexity: constant)
+
+            void erase(int i) {
+                int c = cellOf(i);
+                if (c>=0) {
+                    if (prev[i]>=0)
+                        next[prev[i]] = next[i];
+                    else
+                        head[c] = next[i];
+                    if (next[i]>=0)
+                        prev[next[i]] = prev[i];
+                    cell[i] = next[i] = prev[i] = -1;
+                }
+            } //!< remove particle index i if present (complexity: constant)
+
+            void move(int i, int dst) {
+                if (cellOf(i)!=dst) {
+                    erase(i);
+                    insert(i, dst);
+                }
+            } //!< move particle index i to another cell (complexity: constant)
 
             void move(int i, const CellPoint &src, const CellPoint &dst) {
-                assert( (*this)[src].count(i)==1 && "i not present in old cell");
-                assert( (*this)[dst].count(i)==0 && "i already in new cell");
-                (*this)[src].erase(i);
-                (*this)[dst].insert(i);
-            } //!< move particle index i from one cell to another (complexity: N log N)
-
-            void resize(const Point &box, double cutoff) {
-                clear();
+                assert( cellOf(i)==index(src) && "i not present in old cell");
+                move(i, index(dst));
+            } //!< move particle index i from one cell to another (complexity: constant)
+
+            void resize(const Point &box, double cutoff, const std::array<bool,3> &periodic={{true,true,true}}) {
+                if (cutoff<=0 || box.minCoeff()<=0)
+                    throw std::runtime_error("celllist error: cutoff and box must be positive");
                 halfbox = 0.5*box;
-                cellsize = cutoff;
-                KLM = (box/cellsize).array().round().template cast<int>();
-                if (KLM.minCoeff()>=3) {
-                    cells.resize(KLM[0]+1);
-                    for (auto &k : cells) {
-                        k.resize(KLM[1]+1);
-                        for (auto &l : k)
-                            l.resize(KLM[2]+1);
-                    }
-                } else
-                    throw std::runtime_error("celllist error: too few grid point - cutoff or box too small");
+                pbc = periodic;
+                KLM = (box/cutoff).array().floor().template cast<int>();
+                KLM = (KLM.array()-1).cwiseMax(0); // at least one cell; cell size >= cutoff
+                cellsize = box.cwiseQuotient( (KLM.array()+1).template cast<double>().matrix() );
+                cellsize_inv = cellsize.cwiseInverse();
+                head.assign( (KLM[0]+1)*(KLM[1]+1)*(KLM[2]+1), -1 );
+                cell.clear();
+                next.clear();
+                prev.clear();
+                buildNeighbors();
             }
 
+            template<class Tgeometry>
+                void resize(const Tgeometry &geo, double cutoff) {
+                    Point box = geo.getLength();
+                    Point r = geo.vdist(Point::Zero(), 0.75*box); // periodic dimensions are wrapped
+                    std::array<bool,3> periodic;
+                    for (int d=0; d<3; d++)
+                        periodic[d] = std::fabs(r[d]) < 0.5*box[d];
+                    resize(box, cutoff, periodic);
+                } //!< Resize to geometry bounding box; periodicity is detected from minimum image distances
+
             void clear() {
-                for (auto &k : cells)
-                    for (auto &l : k)
-                        for (auto &m : l)
-                            m.clear();
+                std::fill(head.begin(), head.end(), -1);
+                std::fill(cell.begin(), cell.end(), -1);
+                std::fill(next.begin(), next.end(), -1);
+                std::fill(prev.begin(), prev.end(), -1);
             } //<! clear all index in cell list
 
             template<class Tpvec, class T=std::function<Point(const typename Tpvec::value_type&)>>
                 void update(const Tpvec &p, T getpos = [](auto &i){return i;} ) {
                     clear();
                     for (size_t i=0; i<p.size(); i++)
-                        (*this)[ p2c( getpos(p[i]) ) ].insert(i);
-                }
+                        insert(i, index( p2c( getpos(p[i]) ) ));
+                } //!< rebuild from all points in `p`
+
+            template<class Tfunc>
+                void forEachInCell(int c, Tfunc f) const {
+                    for (int i=head[c]; i>=0; i=next[i])
+                        f(i);
+                } //!< Call `f(i)` for all index in cell c
+
+            template<class Tfunc>
+                void forEachNeighbor(int c, Tfunc f) const {
+                    for (int n=nboffset[c]; n<nboffset[c+1]; n++)
+                        forEachInCell(nbcells[n], f);
+                } //!< Call `f(i)` for all index in neighboring+own cells to cell c
 
-            void neighbors(const Eigen::Vector3i &c, std::vector<int> &index, bool clear=true) const {
+            void neighbors(const CellPoint &c, std::vector<int> &index, bool clear=true) const {
                 if (clear)
                     index.clear();
-                int cnt=0;
-                std::array<int,3>
-                    k = {{ c[0]-1, c[0], c[0]+1 }},
-                    l = {{ c[1]-1, c[1], c[1]+1 }},
-                    m = {{ c[2]-1, c[2], c[2]+1 }};
-                if (k[0]<0) k[0]=KLM[0]; else if (k[2]>KLM[0]) k[2]=0;
-                if (l[0]<0) l[0]=KLM[1]; else if (l[2]>KLM[1]) l[2]=0;
-                if (m[0]<0) m[0]=KLM[2]; else if (m[2]>KLM[2]) m[2]=0;
-                for (int _k : k)
-                    for (int _l : l)
-                        for (int _m : m) {
-                            cnt++;
-                            auto& s = cells[_k][_l][_m];
-                            std::copy(s.begin(), s.end(), std::back_inserter(index));
-                        }
-                assert(cnt==27);
+                forEachNeighbor( this->index(c), [&index](int i){ index.push_back(i); } );
             } //!< Index from all 26+1 neighboring+own cells (complexity: N neighbors)
         };
 
@@ -116,26 +210,51 @@ namespace Faunus {
         Point box = {10,20,6};
         CellList<Eigen::Vector3i> l;
         l.resize(box, 2);
-        CHECK( l.KLM==Eigen::Vector3i(5,10,3) );
-        CHECK( l.p2c( {5,10,3} ) == l.KLM );
+        CHECK( l.KLM==Eigen::Vector3i(4,9,2) );
+        CHECK( l.size()==5*10*3 );
+        CHECK( l.p2c( {4.9,9.9,2.9} ) == l.KLM );
+        CHECK( l.p2c( {5.1,10.1,3.1} ) == Eigen::Vector3i(0,0,0) ); // periodic wrap
         CHECK( l.p2c( {-5,-10,-3} ) == Eigen::Vector3i(0,0,0) );
-        CHECK( l.p2c( {0,0,0} ) == Eigen::Vector3i(3,5,2) );
+        CHECK( l.p2c( {0,0,0} ) == Eigen::Vector3i(2,5,1) );
 
         std::vector<int> index; // index of neighbors (and self) in...
         std::vector<Point> vec; // ...array of points
 
-        vec = {{0,0,0}, {0,3,0}};
+        vec = {{0,0,0}, {0,5,0}};
         l.update(vec);
         l.neighbors( l.p2c( vec[0] ), index);
         CHECK( index.size()==1 );  // alone by myself...
         CHECK( index.front()==0 ); // ...am I really me?
 
-        vec = {{0,0,0}, {0,-3,0}};
+        vec = {{0,0,0}, {0,-1.5,0}};
         l.update(vec);
         l.neighbors( l.p2c( vec[0] ), index);
         CHECK( index.size()==2 );  // now we're two
         l.neighbors( l.p2c( vec[1] ), index);
         CHECK( index.size()==2 );  // now we're two
+
+        l.move(1, l.index( l.p2c({0,5,0}) ));
+        l.neighbors( l.p2c( vec[0] ), index);
+        CHECK( index.size()==1 );  // moved away
+        l.erase(0);
+        CHECK( l.cellOf(0)==-1 );
+        l.neighbors( l.p2c( vec[0] ), index);
+        CHECK( index.empty() );
+
+        vec = {{0,-9.9,0}, {0,9.9,0}}; // neighbors only through periodic boundary
+        l.update(vec);
+        l.neighbors( l.p2c( vec[0] ), index);
+        CHECK( index.size()==2 );
+        l.resize(box, 2, {{true,false,true}});
+        l.update(vec);
+        l.neighbors( l.p2c( vec[0] ), index);
+        CHECK( index.size()==1 );
+        CHECK( l.p2c( {0,-15,0} ) == Eigen::Vector3i(2,0,1) ); // clamped
+
+        l.resize({3,3,3}, 2); // single cell; all are neighbors, no duplicates
+        l.update(vec);
+        l.neighbors( l.p2c( vec[0] ), index);
+        CHECK( index.size()==2 );
     }
 #endif
 } // namespace
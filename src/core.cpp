@@ -1,5 +1,26 @@
 #include "core.h"
 
+#ifdef ENABLE_ALLOCCOUNT
+#include <atomic>
+#include <new>
+#include <cstdlib>
+
+static std::atomic<size_t> _allocations(0); // number of calls to global `operator new`
+
+void* operator new(std::size_t n) {
+    _allocations++;
+    if (void *p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+size_t Faunus::allocations() { return _allocations; }
+#else
+size_t Faunus::allocations() { return 0; }
+#endif
+
 double Faunus::_round(double x, int n) {
     std::stringstream o;
     o << std::setprecision(n) << x;
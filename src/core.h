@@ -75,6 +75,7 @@ namespace Faunus {
     json openjson( const std::string &file ); //!< Read json file into json object (w. syntax check)
 
     double _round(double x, int n=3); //!< Round to n number of significant digits
+    size_t allocations(); //!< Number of heap allocations so far; counted only if compiled with `ENABLE_ALLOCCOUNT`
     void _roundjson(json &j, int n=3); // round float objects to n number of significant digits
     double value_inf(const json &j, const std::string &key); //!< Extract floating point from json and allow for 'inf' and '-inf'
 
@@ -462,7 +463,7 @@ namespace Faunus {
                 Particle() : Properties()... {}
 
                 void rotate(const Eigen::Quaterniond &q, const Eigen::Matrix3d &m) {
-                    _rotate<Properties...>(q, m, dynamic_cast<Properties&>(*this)...);
+                    _rotate<Properties...>(q, m, static_cast<Properties&>(*this)...);
                 } //!< Rotate all internal coordinates if needed
 
                 EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -479,7 +480,7 @@ namespace Faunus {
             a.id = j.value("id", a.id);
             a.mw = j.value("mw", a.mw);
             a.pos = j.value("pos", a.pos);
-            from_json<Properties...>(j, dynamic_cast<Properties&>(a)...);
+            from_json<Properties...>(j, static_cast<Properties&>(a)...);
         }
 
     using ParticleAllProperties = Particle<Radius,Dipole,Charge,Quadrupole,Cigar>;
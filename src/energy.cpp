@@ -5,8 +5,14 @@ void Faunus::Energy::Energybase::to_json(json &j) const {}
 
 void Faunus::Energy::Energybase::sync(Energybase *, Change &) {}
 
+void Faunus::Energy::Energybase::commit(Change &, bool) {}
+
 void Faunus::Energy::Energybase::init() {}
 
+double Faunus::Energy::Energybase::delta(Energybase *old, Change &change) {
+    return energy(change) - old->energy(change);
+}
+
 void Faunus::Energy::to_json(json &j, const Energybase &base) {
     assert(!base.name.empty());
     if (!base.cite.empty())
@@ -21,6 +27,7 @@ void Faunus::Energy::EwaldData::update(const Point &box) {
     int kVectorsLength = (2*kcc+1) * (2*kcc+1) * (2*kcc+1) - 1;
     if (kVectorsLength == 0) {
         kVectors.resize(3,1);
+        kIndices.setZero(3,1);
         Aks.resize(1);
         kVectors.col(0) = Point(1,0,0); // Just so it is not the zero-vector
         Aks[0] = 0;
@@ -30,6 +37,7 @@ void Faunus::Energy::EwaldData::update(const Point &box) {
     } else {
         double kc2 = kc*kc;
         kVectors.resize(3, kVectorsLength);
+        kIndices.resize(3, kVectorsLength);
         Aks.resize(kVectorsLength);
         kVectorsInUse = 0;
         kVectors.setZero();
@@ -56,6 +64,7 @@ void Faunus::Energy::EwaldData::update(const Point &box) {
                         if( (dkx2/kc2) + (dky2/kc2) + (dkz2/kc2) > 1)
                             continue;
                     kVectors.col(kVectorsInUse) = kv;
+                    kIndices.col(kVectorsInUse) << kx, ky, kz;
                     Aks[kVectorsInUse] = factor*std::exp(-k2/(4*alpha*alpha))/k2;
                     kVectorsInUse++;
                 }
@@ -65,6 +74,7 @@ void Faunus::Energy::EwaldData::update(const Point &box) {
         Qdip.resize(kVectorsInUse);
         Aks.conservativeResize(kVectorsInUse);
         kVectors.conservativeResize(3,kVectorsInUse);
+        kIndices.conservativeResize(3,kVectorsInUse);
     }
 }
 
@@ -74,6 +84,7 @@ void Faunus::Energy::from_json(const json &j, EwaldData &d) {
     d.kc = j.at("kcutoff");
     d.ipbc = j.value("ipbc", false);
     d.spherical_sum = j.value("spherical_sum", true);
+    d.groupcache = j.value("groupcache", false);
     d.lB = pc::lB( j.at("epsr") );
     d.eps_surf = j.value("epss", 0.0);
     d.const_inf = (d.eps_surf < 1) ? 0 : 1; // if unphysical (<1) use epsr infinity for surrounding medium
@@ -83,6 +94,8 @@ void Faunus::Energy::to_json(json &j, const EwaldData &d) {
     j = {{"lB", d.lB}, {"ipbc", d.ipbc}, {"epss", d.eps_surf},
         {"alpha", d.alpha}, {"cutoff", d.rc}, {"kcutoff", d.kc},
         {"wavefunctions", d.kVectors.cols()}, {"spherical_sum", d.spherical_sum}};
+    if (d.groupcache)
+        j["groupcache"] = true;
 }
 
 double Faunus::Energy::Example2D::energy(Change &change) {
@@ -7,8 +7,12 @@
 #include "multipole.h"
 #include "penalty.h"
 #include "mpi.h"
+#include "celllist.h"
+#include "pme.h"
+#include "executor.h"
 #include <Eigen/Dense>
 #include <set>
+#include <numeric>
 
 #ifdef ENABLE_POWERSASA
 #include <power_sasa.h>
@@ -23,9 +27,15 @@ namespace Faunus {
                 keys key=NONE;
                 std::string name;
                 std::string cite;
+                double umin=-pc::infty; //!< lower bound of `energy()`; used for early rejection
+                bool earlyexit=false; //!< if true, `energy()` may return infinity as soon as an infinite contribution is found
+                bool fused=false; //!< true if `delta()` is safe to use instead of `energy()` on both states
+                bool journal=false; //!< true if a single instance can describe both states of a journaled Space, see `commit()`
                 virtual double energy(Change&)=0; //!< energy due to change
+                virtual double delta(Energybase *old, Change &change); //!< energy change, new minus `old` which is the same term in the old state
                 virtual void to_json(json &j) const;; //!< json output
                 virtual void sync(Energybase*, Change&);
+                virtual void commit(Change&, bool accept); //!< with a journaled Space, called after a move where the current state is the trial state if `accept`, otherwise the old state
                 virtual void init(); //!< reset and initialize
                 virtual inline void force(std::vector<Point> &forces) {}; // update forces on all particles
         };
@@ -38,12 +48,15 @@ namespace Faunus {
         struct EwaldData {
             typedef std::complex<double> Tcomplex;
             Eigen::Matrix3Xd kVectors; // k-vectors, 3xK
+            Eigen::Matrix3Xi kIndices; // k-vectors in units of 2*pi/L, 3xK
             Eigen::VectorXd Aks;       // 1xK, to minimize computational effort (Eq.24,DOI:10.1063/1.481216)
             Eigen::VectorXcd Qion, Qdip; // 1xK
             double alpha, rc, kc, check_k2_zero, lB;
             double const_inf, eps_surf;
             bool spherical_sum=true;
             bool ipbc=false;
+            bool groupcache=false;     // keep structure factors of each group
+            Eigen::MatrixXcd Qgroup;   // KxG structure factors of each group if `groupcache`
             int kVectorsInUse=0;
             Point L; //!< Box dimensions
 
@@ -78,67 +91,236 @@ namespace Faunus {
         }
 #endif
 
+        /**
+         * @brief Loop over particles in `change` with contributions to either the new or the old state
+         *
+         * The change may span several groups, atom subsets and particles that are activated or
+         * deactivated. Old and new states share the particle layout so that a particle
+         * contributes to a state only if it is within the active range of its group.
+         * `f(particle, sign)` is called with `sign=1` for particles in `spc` and `sign=-1`
+         * for particles in `old`.
+         */
+        template<class Tspace, class Tfunc>
+            void forEachChangedParticle(Tspace &spc, Tspace &old, const Change::data &d, Tfunc f) {
+                assert(spc.p.size() == old.p.size());
+                auto &g = spc.groups.at(d.index);
+                auto &gold = old.groups.at(d.index);
+                int offset = g.begin()-spc.p.begin();
+                int nnew = g.size(), nold = gold.size();
+                auto add = [&](int i) {
+                    if (i<nnew)
+                        f( spc.p[offset+i], 1.0 );
+                    if (i<nold)
+                        f( old.p[offset+i], -1.0 );
+                };
+                if (d.all || d.atoms.empty())
+                    for (int i=0; i<std::max(nnew,nold); i++)
+                        add(i);
+                else
+                    for (int i : d.atoms)
+                        add(i);
+            }
+
+        template<class Tspace, class Tfunc>
+            void forEachChangedParticle(Tspace &spc, Tspace &old, const Change &change, Tfunc f) {
+                for (auto &d : change.groups)
+                    forEachChangedParticle(spc, old, d, f);
+            }
+
+        /**
+         * @brief Loop over charges that differ between the new and the old state
+         *
+         * As `forEachChangedParticle()` but `f(position, charge)` is called with signed charges.
+         * For groups where only charges have changed (`Change::data::charge`), positions
+         * are shared by the two states and `f` is called once per particle with the
+         * charge difference.
+         */
+        template<class Tspace, class Tfunc>
+            void forEachChangedCharge(Tspace &spc, Tspace &old, const Change &change, Tfunc f) {
+                for (auto &d : change.groups)
+                    if (d.charge) {
+                        auto &g = spc.groups.at(d.index);
+                        int offset = g.begin()-spc.p.begin();
+                        auto add = [&](int i) {
+                            double dq = spc.p[offset+i].charge - old.p[offset+i].charge;
+                            if (dq!=0)
+                                f( spc.p[offset+i].pos, dq );
+                        };
+                        if (d.all || d.atoms.empty())
+                            for (int i=0; i<(int)g.size(); i++)
+                                add(i);
+                        else
+                            for (int i : d.atoms)
+                                add(i);
+                    } else
+                        forEachChangedParticle(spc, old, d, [&](const typename Tspace::Tparticle &p, double sign) {
+                                f( p.pos, sign*p.charge );
+                                } );
+            }
+
+        /**
+         * @brief Loop over particles recorded in the journal of a single Space
+         *
+         * Here the old state is given by the old values in `Space::journal`. The journal
+         * must hold single particles and groups, i.e. not everything (`Journal::all`).
+         * `f(k, isnew, isold)` is called for each journal entry `k` where `isnew` and
+         * `isold` tell whether the particle is within the active range of its group in
+         * the current and in the recorded state, respectively.
+         */
+        template<class Tspace, class Tfunc>
+            void forEachJournalEntry(Tspace &spc, Tfunc f) {
+                auto &j = spc.journal;
+                assert(!j.all);
+                const typename Tspace::Journal::GroupData *d = nullptr;
+                for (size_t k=0; k<j.index.size(); k++) {
+                    if (d==nullptr || d->index!=j.group[k]) // entries of a group are mostly consecutive
+                        d = &*std::find_if(j.groups.begin(), j.groups.end(), [&](auto &i){ return i.index==j.group[k]; });
+                    auto &g = spc.groups[d->index];
+                    int i = j.index[k] - (g.begin()-spc.p.begin()); // index relative to group
+                    f( k, i<int(g.size()), i<d->size );
+                }
+            }
+
+        /** @brief As `forEachChangedParticle()` but with the old state given by the journal of `spc` */
+        template<class Tspace, class Tfunc>
+            void forEachJournaledParticle(Tspace &spc, Tfunc f) {
+                forEachJournalEntry(spc, [&](size_t k, bool isnew, bool isold) {
+                        if (isnew)
+                            f( spc.p[spc.journal.index[k]], 1.0 );
+                        if (isold)
+                            f( spc.journal.p[k], -1.0 );
+                        } );
+            }
+
+        /**
+         * @brief As `forEachChangedCharge()` but with the old state given by the journal of `spc`
+         *
+         * Entries where the position is unchanged result in a single call with the charge
+         * difference, if any, so that recorded but unmodified particles are skipped.
+         */
+        template<class Tspace, class Tfunc>
+            void forEachJournaledCharge(Tspace &spc, Tfunc f) {
+                forEachJournalEntry(spc, [&](size_t k, bool isnew, bool isold) {
+                        auto &p = spc.p[spc.journal.index[k]];
+                        auto &q = spc.journal.p[k];
+                        if (isnew && isold && p.pos==q.pos) {
+                            if (p.charge!=q.charge)
+                                f( p.pos, p.charge-q.charge );
+                        } else {
+                            if (isnew)
+                                f( p.pos, p.charge );
+                            if (isold)
+                                f( q.pos, -q.charge );
+                        }
+                        } );
+            }
+
         /** @brief recipe or policies for ion-ion ewald */
         template<class Tspace, bool eigenopt=false /** use Eigen matrix ops where possible */>
             struct PolicyIonIon  {
                 typedef typename Tspace::Tpvec::iterator iter;
                 Tspace *spc;
                 Tspace *old=nullptr; // set only if key==NEW at first call to `sync()`
+                mutable std::vector<Point> pos;     // scratch space for positions...
+                mutable std::vector<double> charge; // ...and charges of changed particles
 
                 PolicyIonIon(Tspace &spc) : spc(&spc) {}
 
                 void updateComplex(EwaldData &data) const {
                     if (eigenopt)
                         if (data.ipbc==false) {
-                            auto pos = asEigenMatrix(spc->p.begin(), spc->p.end(), &Tspace::Tparticle::pos); //  Nx3
-                            auto charge = asEigenVector(spc->p.begin(), spc->p.end(), &Tspace::Tparticle::charge); // Nx1
-                            Eigen::MatrixXd kr = pos.matrix() * data.kVectors; // Nx3 * 3xK = NxK
-                            data.Qion.real() = (kr.array().cos().colwise()*charge).colwise().sum();
-                            data.Qion.imag() = kr.array().sin().colwise().sum();
+                            data.Qion.setZero();
+                            for (auto &g : spc->groups)
+                                if (!g.empty()) {
+                                    auto pos = asEigenMatrix(g.begin(), g.end(), &Tspace::Tparticle::pos); //  Nx3
+                                    auto charge = asEigenVector(g.begin(), g.end(), &Tspace::Tparticle::charge); // Nx1
+                                    Eigen::MatrixXd kr = pos.matrix() * data.kVectors; // Nx3 * 3xK = NxK
+                                    data.Qion.real() += (kr.array().cos().colwise()*charge).colwise().sum().matrix().transpose();
+                                    data.Qion.imag() += (kr.array().sin().colwise()*charge).colwise().sum().matrix().transpose();
+                                }
                             return;
                         }
-                    for (int k=0; k<data.kVectors.cols(); k++) {
-                        const Point& kv = data.kVectors.col(k);
-                        EwaldData::Tcomplex Q(0,0);
-                        if (data.ipbc)
-                            for (auto &i : spc->p)
-                                Q += kv.cwiseProduct(i.pos).array().cos().prod() * i.charge;
-                        else
-                            for (auto &i : spc->p) {
-                                double dot = kv.dot(i.pos);
-                                Q += i.charge * EwaldData::Tcomplex( std::cos(dot), std::sin(dot) );
+                    executor.parallel_for(data.kVectors.cols(), [&](size_t first, size_t last) {
+                            for (int k=first; k<int(last); k++) {
+                                const Point& kv = data.kVectors.col(k);
+                                EwaldData::Tcomplex Q(0,0);
+                                for (auto &g : spc->groups) // active particles only
+                                    if (data.ipbc)
+                                        for (auto &i : g)
+                                            Q += kv.cwiseProduct(i.pos).array().cos().prod() * i.charge;
+                                    else
+                                        for (auto &i : g) {
+                                            double dot = kv.dot(i.pos);
+                                            Q += i.charge * EwaldData::Tcomplex( std::cos(dot), std::sin(dot) );
+                                        }
+                                data.Qion[k] = Q;
                             }
-                        data.Qion[k] = Q;
-                    }
+                            }, std::max(100000/std::max(int(spc->p.size()), 1), 1)); // k-vectors in chunks of ~1e5 terms
                 } //!< Update all k vectors
 
-                void updateComplex(EwaldData &data, iter begin, iter end) const {
+                template<class Tgroup>
+                    Eigen::VectorXcd groupComplex(const EwaldData &data, const Tgroup &g) const {
+                        Eigen::VectorXcd Q(data.kVectors.cols());
+                        for (int k=0; k<data.kVectors.cols(); k++) {
+                            const Point& kv = data.kVectors.col(k);
+                            Q[k] = 0;
+                            if (data.ipbc)
+                                for (auto &i : g)
+                                    Q[k] += kv.cwiseProduct(i.pos).array().cos().prod() * i.charge;
+                            else
+                                for (auto &i : g) {
+                                    double dot = kv.dot(i.pos);
+                                    Q[k] += i.charge * EwaldData::Tcomplex( std::cos(dot), std::sin(dot) );
+                                }
+                        }
+                        return Q;
+                    } //!< Structure factors of a single group
+
+                /*
+                 * Incremental update of the structure factors from the particles in `change`.
+                 * The cost scales with the number of changed particles times the number of k vectors.
+                 */
+                void updateComplex(EwaldData &data, const Change &change) const {
                     assert(old!=nullptr);
-                    assert(spc->p.size() == old->p.size());
-                    size_t ibeg = std::distance(spc->p.begin(), begin); // it->index
-                    size_t iend = std::distance(spc->p.begin(), end);   // it->index
+                    pos.clear();
+                    charge.clear(); // negative charges remove old contributions
+                    forEachChangedCharge(*spc, *old, change, [&](const Point &r, double q) {
+                            pos.push_back( r );
+                            charge.push_back( q );
+                            } );
+                    addComplex(data, pos, charge);
+                } //!< Optimized update of changed particles. Require access to old state through `old` pointer
+
+                void updateComplex(EwaldData &data, const typename Tspace::Journal&) const {
+                    pos.clear();
+                    charge.clear();
+                    forEachJournaledCharge(*spc, [&](const Point &r, double q) {
+                            pos.push_back( r );
+                            charge.push_back( q );
+                            } );
+                    addComplex(data, pos, charge);
+                } //!< Optimized update of particles recorded in the journal of a single Space
+
+                void addComplex(EwaldData &data, const std::vector<Point> &pos, const std::vector<double> &charge) const {
                     for (int k=0; k<data.kVectors.cols(); k++) {
                         auto& Q = data.Qion[k];
                         Point q = data.kVectors.col(k);
                         if (data.ipbc)
-                            for (size_t i=ibeg; i<=iend; i++) {
-                                Q +=  q.cwiseProduct( spc->p[i].pos ).array().cos().prod() * spc->p[i].charge;
-                                Q -=  q.cwiseProduct( old->p[i].pos ).array().cos().prod() * old->p[i].charge;
-                            }
+                            for (size_t i=0; i<pos.size(); i++)
+                                Q += q.cwiseProduct( pos[i] ).array().cos().prod() * charge[i];
                         else
-                            for (size_t i=ibeg; i<=iend; i++) {
-                                double _new = q.dot(spc->p[i].pos);
-                                double _old = q.dot(old->p[i].pos);
-                                Q += spc->p[i].charge * EwaldData::Tcomplex( std::cos(_new), std::sin(_new) );
-                                Q -= old->p[i].charge * EwaldData::Tcomplex( std::cos(_old), std::sin(_old) );
+                            for (size_t i=0; i<pos.size(); i++) {
+                                double dot = q.dot(pos[i]);
+                                Q += charge[i] * EwaldData::Tcomplex( std::cos(dot), std::sin(dot) );
                             }
                     }
-                } //!< Optimized update of k subset. Require access to old positions through `old` pointer
+                } //!< Add contributions from charges at given positions to all k vectors
 
                 double selfEnergy(const EwaldData &d) {
                     double E = 0;
-                    for (auto& i : spc->p)
-                        E += i.charge * i.charge;
+                    for (auto &g : spc->groups)
+                        for (auto& i : g)
+                            E += i.charge * i.charge;
                     return -d.alpha*E / std::sqrt(pc::pi) * d.lB;
                 }
 
@@ -146,8 +328,9 @@ namespace Faunus {
                     if (d.const_inf < 0.5)
                         return 0;
                     Point qr(0,0,0);
-                    for (auto &i : spc->p)
-                        qr += i.charge*i.pos;
+                    for (auto &g : spc->groups)
+                        for (auto &i : g)
+                            qr += i.charge*i.pos;
                     return d.const_inf * 2 * pc::pi / ( (2*d.eps_surf+1) * spc->geo.getVolume() ) * qr.dot(qr) * d.lB;
                 }
 
@@ -162,6 +345,110 @@ namespace Faunus {
                 }
             };
 
+        /**
+         * @brief Ion-ion Ewald policy using trigonometric recurrences
+         *
+         * Since k-vectors are integer multiples of 2*pi/L, exp(ik.r) is a product of
+         * per-axis factors that for all multiples are obtained from the first by complex
+         * multiplication. Particles are processed in blocks where the factors are stored
+         * contiguously for vectorization, while k-vectors are distributed over threads.
+         */
+        template<class Tspace>
+            struct PolicyIonIonRecurrence : public PolicyIonIon<Tspace> {
+                typedef PolicyIonIon<Tspace> base;
+                using base::spc;
+                using base::old;
+                using base::pos;
+                using base::charge;
+                static const int blocksize = 64;
+                mutable std::array<std::vector<double>,3> re, im; // per-axis factors (scratch)
+
+                PolicyIonIonRecurrence(Tspace &spc) : base(spc) {}
+
+                void addComplex(EwaldData &data, const std::vector<Point> &pos, const std::vector<double> &charge) const {
+                    const int K = data.kIndices.cols();
+                    const int nmax = (K>0) ? data.kIndices.cwiseAbs().maxCoeff() : 0;
+                    const int stride = 2*nmax+1; // multiples from -nmax to nmax
+                    for (int d=0; d<3; d++) {
+                        re[d].resize(stride*blocksize);
+                        im[d].resize(stride*blocksize);
+                    }
+                    for (size_t first=0; first<pos.size(); first+=blocksize) {
+                        const int n = std::min(size_t(blocksize), pos.size()-first);
+                        for (int d=0; d<3; d++) // per-axis factors, exp(i*2*pi*m*r/L), stored as [m][particle]
+                            for (int p=0; p<n; p++) {
+                                double phase = 2*pc::pi * pos[first+p][d] / data.L[d];
+                                EwaldData::Tcomplex e1(std::cos(phase), std::sin(phase)), e(1,0);
+                                for (int m=0; m<=nmax; m++) {
+                                    re[d][(nmax+m)*blocksize+p] = re[d][(nmax-m)*blocksize+p] = e.real();
+                                    im[d][(nmax+m)*blocksize+p] = e.imag();
+                                    im[d][(nmax-m)*blocksize+p] = -e.imag();
+                                    e *= e1;
+                                }
+                            }
+                        const double *q = &charge[first];
+                        auto kloop = [&](size_t kfirst, size_t klast) {
+                            for (int k=kfirst; k<int(klast); k++) {
+                                int o[3];
+                                for (int d=0; d<3; d++)
+                                    o[d] = (nmax + data.kIndices(d,k)) * blocksize;
+                                const double *xr=&re[0][o[0]], *yr=&re[1][o[1]], *zr=&re[2][o[2]];
+                                const double *xi=&im[0][o[0]], *yi=&im[1][o[1]], *zi=&im[2][o[2]];
+                                double sr=0, si=0;
+                                if (data.ipbc) {
+#pragma omp simd reduction (+:sr)
+                                    for (int p=0; p<n; p++)
+                                        sr += q[p] * xr[p] * yr[p] * zr[p]; // product of cosines
+                                } else {
+#pragma omp simd reduction (+:sr,si)
+                                    for (int p=0; p<n; p++) {
+                                        double ar = xr[p]*yr[p] - xi[p]*yi[p];
+                                        double ai = xr[p]*yi[p] + xi[p]*yr[p];
+                                        sr += q[p] * (ar*zr[p] - ai*zi[p]);
+                                        si += q[p] * (ar*zi[p] + ai*zr[p]);
+                                    }
+                                }
+                                data.Qion[k] += EwaldData::Tcomplex(sr, si);
+                            }
+                        };
+                        executor.parallel_for(K, kloop, std::max(100000/n, 1)); // k-vectors in chunks of ~1e5 terms
+                    }
+                } //!< Add contributions from charges at given positions to all k vectors
+
+                void updateComplex(EwaldData &data) const {
+                    pos.clear();
+                    charge.clear();
+                    for (auto &g : spc->groups) // active particles only
+                        for (auto &i : g) {
+                            pos.push_back( i.pos );
+                            charge.push_back( i.charge );
+                        }
+                    data.Qion.setZero();
+                    addComplex(data, pos, charge);
+                } //!< Update all k vectors
+
+                void updateComplex(EwaldData &data, const Change &change) const {
+                    assert(old!=nullptr);
+                    pos.clear();
+                    charge.clear(); // negative charges remove old contributions
+                    forEachChangedCharge(*spc, *old, change, [&](const Point &r, double q) {
+                            pos.push_back( r );
+                            charge.push_back( q );
+                            } );
+                    addComplex(data, pos, charge);
+                } //!< Optimized update of changed particles. Require access to old state through `old` pointer
+
+                void updateComplex(EwaldData &data, const typename Tspace::Journal&) const {
+                    pos.clear();
+                    charge.clear();
+                    forEachJournaledCharge(*spc, [&](const Point &r, double q) {
+                            pos.push_back( r );
+                            charge.push_back( q );
+                            } );
+                    addComplex(data, pos, charge);
+                } //!< Optimized update of particles recorded in the journal of a single Space
+            };
+
 #ifdef DOCTEST_LIBRARY_INCLUDED
         TEST_CASE("[Faunus] Ewald - IonIonPolicy")
         {
@@ -173,6 +460,7 @@ namespace Faunus {
             spc.geo  = R"( {"length": 10} )"_json;
             spc.p[0] = R"( {"pos": [0,0,0], "q": 1.0} )"_json;
             spc.p[1] = R"( {"pos": [1,0,0], "q": -1.0} )"_json;
+            spc.groups.push_back( typename Tspace::Tgroup(spc.p.begin(), spc.p.end()) );
 
             PolicyIonIon<Tspace> ionion(spc);
             EwaldData data = R"({
@@ -193,6 +481,291 @@ namespace Faunus {
             CHECK( ionion.surfaceEnergy(data) == Approx(0.0020943951023931952*data.lB) );
             CHECK( ionion.reciprocalEnergy(data) == Approx(0.0865107467*data.lB) );
         }
+
+        TEST_CASE("[Faunus] Ewald - incremental update")
+        {
+            using doctest::Approx;
+            typedef Space<Geometry::Cuboid, Particle<Charge>> Tspace;
+
+            Tspace spc, old;
+            for (Tspace *s : {&spc, &old}) {
+                s->geo = R"( {"length": 10} )"_json;
+                s->p.resize(10);
+                for (size_t i=0; i<s->p.size(); i++) {
+                    s->p[i].pos = Point(i, 0.5*i, -0.3*i) - Point(4,2,1);
+                    s->p[i].charge = (i%2) ? -1 : 1;
+                }
+                for (int i=0; i<6; i+=2) // three molecules...
+                    s->groups.push_back( typename Tspace::Tgroup(s->p.begin()+i, s->p.begin()+i+2) );
+                s->groups.push_back( typename Tspace::Tgroup(s->p.begin()+6, s->p.end()) ); // ...and salt
+                s->groups.back().atomic = true;
+            }
+
+            PolicyIonIon<Tspace> ionion(spc);
+            ionion.old = &old;
+            EwaldData data = R"({
+                "epsr": 1.0, "alpha": 0.894427190999916, "epss": 1.0,
+                "kcutoff": 5.0, "spherical_sum": true, "cutoff": 5.0})"_json;
+
+            for (bool ipbc : {false, true}) {
+                data.ipbc = ipbc;
+                data.update( spc.geo.getLength() );
+                PolicyIonIon<Tspace> ref(old);
+                ref.updateComplex( data ); // old state
+
+                spc.p[0].pos += Point(0.3,0.1,-0.2); // whole molecule moved...
+                spc.p[1].pos += Point(0.3,0.1,-0.2);
+                spc.p[5].charge = 0.5;               // ...charge of single atom changed...
+                spc.groups[1].deactivate( spc.groups[1].begin(), spc.groups[1].end() ); // ...molecule removed...
+                spc.groups[3].deactivate( spc.groups[3].end()-1, spc.groups[3].end() ); // ...and salt atom removed
+
+                Change c;
+                c.dNpart = true;
+                c.groups.resize(4);
+                c.groups[0].index = 0;
+                c.groups[0].all = true;
+                c.groups[1].index = 1;
+                c.groups[1].all = true;
+                c.groups[2].index = 2;
+                c.groups[2].atoms = {1};
+                c.groups[3].index = 3;
+                c.groups[3].atoms = {3};
+                ionion.updateComplex(data, c);
+                double u = ionion.reciprocalEnergy(data);
+                ionion.updateComplex(data); // all particles
+                CHECK( u == Approx( ionion.reciprocalEnergy(data) ) );
+
+                spc.groups[1].activate( spc.groups[1].inactive().begin(), spc.groups[1].inactive().end() );
+                spc.groups[3].activate( spc.groups[3].inactive().begin(), spc.groups[3].inactive().end() );
+                spc.p = old.p;
+            }
+        }
+
+        TEST_CASE("[Faunus] Ewald - policies")
+        {
+            using doctest::Approx;
+            typedef Space<Geometry::Cuboid, Particle<Charge>> Tspace;
+
+            Tspace spc, old;
+            for (Tspace *s : {&spc, &old}) {
+                s->geo = R"( {"length": [10,12,9]} )"_json;
+                s->p.resize(100);
+                for (size_t i=0; i<s->p.size(); i++) {
+                    s->p[i].pos = Point(0.37*i, 0.53*i, -0.71*i);
+                    s->geo.boundary( s->p[i].pos );
+                    s->p[i].charge = (i%3) ? -0.5 : 1;
+                }
+                s->groups.push_back( typename Tspace::Tgroup(s->p.begin(), s->p.end()) );
+                s->groups.back().atomic = true;
+            }
+            EwaldData data = R"({
+                "epsr": 1.0, "alpha": 0.894427190999916, "epss": 1.0,
+                "kcutoff": 7.0, "spherical_sum": true, "cutoff": 5.0})"_json;
+
+            PolicyIonIon<Tspace> ref(spc);
+            PolicyIonIon<Tspace,true> eigen(spc);
+            PolicyIonIonRecurrence<Tspace> recurrence(spc);
+            recurrence.old = &old;
+            spc.p[70].pos = Point(1,2,3);
+            spc.p[70].charge = 0.3;
+            Change c;
+            c.groups.resize(1);
+            c.groups[0].index = 0;
+            c.groups[0].atoms = {70};
+
+            for (bool ipbc : {false, true}) {
+                data.ipbc = ipbc;
+                data.update( spc.geo.getLength() );
+                ref.updateComplex( data );
+                double u = ref.reciprocalEnergy(data);
+                if (!ipbc) {
+                    eigen.updateComplex( data );
+                    CHECK( eigen.reciprocalEnergy(data) == Approx(u) );
+                }
+                recurrence.updateComplex( data );
+                CHECK( recurrence.reciprocalEnergy(data) == Approx(u) );
+
+                ref.spc = &old; // incremental update from old state
+                ref.updateComplex( data );
+                ref.spc = &spc;
+                recurrence.updateComplex( data, c );
+                CHECK( recurrence.reciprocalEnergy(data) == Approx(u) );
+            }
+
+            spc.p[70].pos = old.p[70].pos; // only the charge differs
+            c.groups[0].charge = true;
+            data.ipbc = false;
+            data.update( spc.geo.getLength() );
+            ref.updateComplex( data );
+            double u = ref.reciprocalEnergy(data);
+            ref.old = &old;
+            for (int i=0; i<2; i++) {
+                ref.spc = &old;
+                ref.updateComplex( data );
+                ref.spc = &spc;
+                if (i==0)
+                    ref.updateComplex( data, c );
+                else
+                    recurrence.updateComplex( data, c );
+                CHECK( ref.reciprocalEnergy(data) == Approx(u) );
+            }
+        }
+#endif
+
+        /**
+         * @brief recipe or policies for ion-dipole ewald
+         *
+         * Charge and dipole contributions to the structure factors are stored in
+         * `Qion` and `Qdip`, respectively. Particles must have the `Dipole` property.
+         */
+        template<class Tspace>
+            struct PolicyIonDip : public PolicyIonIon<Tspace> {
+                typedef PolicyIonIon<Tspace> base;
+                typedef typename Tspace::Tparticle Tparticle;
+                using base::spc;
+                using base::old;
+                mutable std::vector<std::pair<const Tparticle*, double>> changed; // scratch space for changed particles and signs
+
+                PolicyIonDip(Tspace &spc) : base(spc) {}
+
+                static void add(const EwaldData &data, int k, const Tparticle &p, double sign,
+                        EwaldData::Tcomplex &Qion, EwaldData::Tcomplex &Qdip) {
+                    const Point& kv = data.kVectors.col(k);
+                    double q = sign * p.charge;
+                    Point mu = sign * p.mulen * p.mu;
+                    if (data.ipbc) {
+                        Point kr = kv.cwiseProduct(p.pos);
+                        Point c = kr.array().cos(), s = kr.array().sin();
+                        Qion += q * c.prod();
+                        Qdip -= mu.x()*kv.x()*s.x()*c.y()*c.z() + mu.y()*kv.y()*c.x()*s.y()*c.z()
+                            + mu.z()*kv.z()*c.x()*c.y()*s.z(); // mu dot gradient of cosine product
+                    } else {
+                        double dot = kv.dot(p.pos);
+                        EwaldData::Tcomplex e( std::cos(dot), std::sin(dot) );
+                        Qion += q * e;
+                        Qdip += EwaldData::Tcomplex(0, mu.dot(kv)) * e;
+                    }
+                } //!< Add contribution from a single particle to k vector `k`
+
+                void updateComplex(EwaldData &data) const {
+                    for (int k=0; k<data.kVectors.cols(); k++) {
+                        EwaldData::Tcomplex Qion(0,0), Qdip(0,0);
+                        for (auto &g : spc->groups) // active particles only
+                            for (auto &i : g)
+                                add(data, k, i, 1.0, Qion, Qdip);
+                        data.Qion[k] = Qion;
+                        data.Qdip[k] = Qdip;
+                    }
+                } //!< Update all k vectors
+
+                void updateComplex(EwaldData &data, const Change &change) const {
+                    assert(old!=nullptr);
+                    changed.clear(); // negative sign removes old contributions
+                    forEachChangedParticle(*spc, *old, change, [&](const Tparticle &p, double sign) {
+                            changed.push_back( {&p, sign} );
+                            } );
+                    for (int k=0; k<data.kVectors.cols(); k++)
+                        for (auto &i : changed)
+                            add(data, k, *i.first, i.second, data.Qion[k], data.Qdip[k]);
+                } //!< Optimized update of changed particles. Require access to old state through `old` pointer
+
+                void updateComplex(EwaldData &data, const typename Tspace::Journal&) const {
+                    changed.clear();
+                    forEachJournaledParticle(*spc, [&](const Tparticle &p, double sign) {
+                            changed.push_back( {&p, sign} );
+                            } );
+                    for (int k=0; k<data.kVectors.cols(); k++)
+                        for (auto &i : changed)
+                            add(data, k, *i.first, i.second, data.Qion[k], data.Qdip[k]);
+                } //!< Optimized update of particles recorded in the journal of a single Space
+
+                double selfEnergy(const EwaldData &d) {
+                    double qq=0, mumu=0;
+                    for (auto &g : spc->groups)
+                        for (auto& i : g) {
+                            qq += i.charge * i.charge;
+                            mumu += i.mulen * i.mulen;
+                        }
+                    return -( d.alpha*qq + 2*std::pow(d.alpha,3)/3*mumu ) / std::sqrt(pc::pi) * d.lB;
+                }
+
+                double surfaceEnergy(const EwaldData &d) {
+                    if (d.const_inf < 0.5)
+                        return 0;
+                    Point M(0,0,0); // total dipole moment of the cell
+                    for (auto &g : spc->groups)
+                        for (auto &i : g)
+                            M += i.charge*i.pos + i.mulen*i.mu;
+                    return d.const_inf * 2 * pc::pi / ( (2*d.eps_surf+1) * spc->geo.getVolume() ) * M.dot(M) * d.lB;
+                }
+
+                double reciprocalEnergy(const EwaldData &d) {
+                    double E = 0;
+                    for (int k=0; k<d.Qion.size(); k++)
+                        E += d.Aks[k] * std::norm( d.Qion[k] + d.Qdip[k] );
+                    return 2 * pc::pi / spc->geo.getVolume() * E * d.lB;
+                }
+            };
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+        TEST_CASE("[Faunus] Ewald - IonDipPolicy")
+        {
+            using doctest::Approx;
+            typedef Space<Geometry::Cuboid, Particle<Charge,Dipole>> Tspace;
+
+            Tspace spc, old, ref;
+            for (Tspace *s : {&spc, &old})
+                s->p.resize(2);
+            ref.p.resize(4);
+            for (Tspace *s : {&spc, &old, &ref}) {
+                s->geo = R"( {"length": 10} )"_json;
+                s->p[0] = R"( {"pos": [0,0,0], "q": 1.0} )"_json;
+                s->groups.push_back( typename Tspace::Tgroup(s->p.begin(), s->p.end()) );
+            }
+            double d = 1e-3; // dipole approximated by two charges
+            for (Tspace *s : {&spc, &old}) {
+                s->p[1] = R"( {"pos": [1,2,0], "q": -0.5} )"_json;
+                s->p[1].mu = Point(1,1,0).normalized();
+                s->p[1].mulen = 0.1;
+            }
+            ref.p[1] = spc.p[1];
+            for (int i : {2,3}) {
+                ref.p[i].charge = (i==2 ? 1 : -1) * spc.p[1].mulen / d;
+                ref.p[i].pos = spc.p[1].pos + (i==2 ? 0.5 : -0.5) * d * spc.p[1].mu;
+            }
+            ref.p[1].mulen = 0;
+
+            PolicyIonDip<Tspace> iondip(spc);
+            PolicyIonIon<Tspace> ionion(ref);
+            iondip.old = &old;
+            EwaldData data = R"({
+                "epsr": 1.0, "alpha": 0.894427190999916, "epss": 1.0,
+                "kcutoff": 7.0, "spherical_sum": true, "cutoff": 5.0})"_json;
+
+            for (bool ipbc : {false, true}) {
+                data.ipbc = ipbc;
+                data.update( spc.geo.getLength() );
+                ionion.updateComplex( data );
+                double u = ionion.reciprocalEnergy(data);
+                CHECK( ionion.surfaceEnergy(data) == Approx( iondip.surfaceEnergy(data) ) );
+
+                iondip.updateComplex( data );
+                CHECK( iondip.reciprocalEnergy(data) == Approx(u).epsilon(1e-4) );
+
+                spc.p[1].rotate( Eigen::Quaterniond( Eigen::AngleAxisd(1.0, Point(0,0,1)) ), Eigen::Matrix3d() );
+                spc.p[1].pos = Point(2,-1,3); // rotate and move
+                Change c;
+                c.groups.resize(1);
+                c.groups[0].index = 0;
+                c.groups[0].atoms = {1};
+                iondip.updateComplex( data, c );
+                u = iondip.reciprocalEnergy(data);
+                iondip.updateComplex( data );
+                CHECK( u == Approx( iondip.reciprocalEnergy(data) ) );
+                spc.p = old.p;
+            }
+            CHECK( iondip.selfEnergy(data) == Approx( -(data.alpha + 2*std::pow(data.alpha,3)/3*0.01 + 0.25*data.alpha) / std::sqrt(pc::pi) * data.lB ) );
+        }
 #endif
 
         /** @brief Ewald summation reciprocal energy */
@@ -202,17 +775,77 @@ namespace Faunus {
                     EwaldData data;
                     Policy policy;
                     Tspace& spc;
+                    Change single;      // scratch space for a single changed group...
+                    Eigen::VectorXcd Q; // ...and structure factors, used by `updateGroups()`
+
+                    /*
+                     * With a journaled Space the trial state overwrites `data`. Until
+                     * `commit()`, `backup` holds the old structure factors or, if the
+                     * volume changed, everything.
+                     */
+                    enum {NOBACKUP, FACTORS, EVERYTHING} backedup=NOBACKUP;
+                    EwaldData backup;
                 public:
 
+                    json autotune; // parameter tuning results, if any
+
                     Ewald(const json &j, Tspace &spc) : policy(spc), spc(spc) {
                         name = "ewald";
+                        fused = true;
                         data = j;
+                        journal = !data.groupcache;
+                        autotune = j.value("autotune", json());
                         init();
                     }
 
+                    void updateAll() {
+                        if (data.groupcache) {
+                            data.Qgroup.resize(data.kVectors.cols(), spc.groups.size());
+                            for (size_t i=0; i<spc.groups.size(); i++)
+                                data.Qgroup.col(i) = policy.groupComplex(data, spc.groups[i]);
+                            data.Qion = data.Qgroup.rowwise().sum();
+                        } else
+                            policy.updateComplex(data);
+                    } //!< Update all k vectors and, if enabled, structure factors of each group
+
+                    template<class Tgroup>
+                        bool translated(const Tgroup &g, const Tgroup &gold, Point &dp) const {
+                            if (data.ipbc || g.empty() || g.size()!=gold.size())
+                                return false;
+                            dp = spc.geo.vdist( g.begin()->pos, gold.begin()->pos );
+                            auto j = gold.begin();
+                            for (auto &i : g) {
+                                if (i.charge!=j->charge || (spc.geo.vdist(i.pos, j->pos)-dp).squaredNorm() > 1e-12)
+                                    return false;
+                                ++j;
+                            }
+                            return true;
+                        } //!< True if all particles in group are displaced by `dp`
+
+                    void updateGroups(Change &change) {
+                        single.groups.resize(1);
+                        for (auto &d : change.groups) {
+                            auto Qg = data.Qgroup.col(d.index);
+                            Point dp;
+                            if (translated(spc.groups[d.index], policy.old->groups[d.index], dp))
+                                for (int k=0; k<data.Qion.size(); k++) { // shift phase; O(K)
+                                    double phase = data.kVectors.col(k).dot(dp);
+                                    auto dQ = Qg[k] * ( EwaldData::Tcomplex(std::cos(phase), std::sin(phase)) - 1.0 );
+                                    data.Qion[k] += dQ;
+                                    Qg[k] += dQ;
+                                }
+                            else {
+                                Q = data.Qion;
+                                single.groups[0] = d;
+                                policy.updateComplex(data, single);
+                                Qg += data.Qion - Q;
+                            }
+                        }
+                    } //!< Update from changed groups, using phase shifts for rigid translations
+
                     void init() override {
                         data.update( spc.geo.getLength() );
-                        policy.updateComplex(data); // brute force. todo: be selective
+                        updateAll();
                     }
 
                     double energy(Change &change) override {
@@ -221,20 +854,25 @@ namespace Faunus {
                             // If the state is NEW (trial state), then update all k-vectors
                             if (key==NEW) {
                                 if (change.all || change.dV) {       // everything changes
+                                    if (spc.journal.enabled) {
+                                        backup = data;
+                                        backedup = EVERYTHING;
+                                    }
                                     data.update( spc.geo.getLength() );
-                                    policy.updateComplex(data);    // update all (expensive!)
+                                    updateAll();    // update all (expensive!)
                                 }
-                                else {
-                                    if (change.groups.size()==1) { // exactly one group is moved
-                                        auto& d = change.groups[0];
-                                        auto& g = spc.groups[d.index];
-                                        if (d.atoms.size()==1)     // exactly one atom is moved
-                                            policy.updateComplex(data, g.begin()+d.atoms[0], g.begin()+d.atoms[0]);
-                                        else
-                                            policy.updateComplex(data, g.begin(), g.end());
-                                    } else
-                                        policy.updateComplex(data);
+                                else if (spc.journal.enabled) {
+                                    backup.Qion = data.Qion;
+                                    backup.Qdip = data.Qdip;
+                                    backedup = FACTORS;
+                                    policy.updateComplex(data, spc.journal); // only recorded particles
                                 }
+                                else if (policy.old==nullptr)
+                                    updateAll();
+                                else if (data.groupcache)
+                                    updateGroups(change);
+                                else
+                                    policy.updateComplex(data, change); // only changed particles
                             }
                             u = policy.selfEnergy(data) + policy.surfaceEnergy(data) + policy.reciprocalEnergy(data);
                         }
@@ -246,15 +884,465 @@ namespace Faunus {
                         assert(other);
                         if (other->key==OLD)
                             policy.old = &(other->spc); // give NEW access to OLD space for optimized updates
-                        data = other->data; // copy everything!
-
+                        if (data.groupcache && !change.all && !change.dV && data.Qgroup.cols()==other->data.Qgroup.cols()) {
+                            data.Qion = other->data.Qion;
+                            for (auto &d : change.groups)
+                                data.Qgroup.col(d.index) = other->data.Qgroup.col(d.index);
+                        } else
+                            data = other->data; // copy everything!
                     } //!< Called after a move is rejected/accepted as well as before simulation
 
+                    void commit(Change &change, bool accept) override {
+                        if (!accept) {
+                            if (backedup==EVERYTHING)
+                                std::swap(data, backup);
+                            else if (backedup==FACTORS) {
+                                data.Qion.swap(backup.Qion);
+                                data.Qdip.swap(backup.Qdip);
+                            }
+                        }
+                        backedup = NOBACKUP;
+                    } //!< Restore structure factors of the old state if the move is rejected
+
                     void to_json(json &j) const override {
                         j = data;
+                        if (!autotune.is_null())
+                            j["autotune"] = autotune;
                     }
             };
 
+        /**
+         * @brief Choose Ewald parameters for a target accuracy at minimum cost
+         *
+         * For a range of `alpha`, the smallest real-space cutoff and reciprocal cutoff that
+         * meet the tolerance (absolute energy error in kT, split evenly between real and
+         * reciprocal space) are found from the error estimates of Kolafa and Perram
+         * (doi:10.1080/08927029208049126). The cost per particle move is predicted
+         * from short timed evaluations of the real-space pair potential and of the
+         * structure factors for the actual system, and the cheapest combination is kept.
+         * If `skin` is negative, all pairs are evaluated so that the real-space cost does
+         * not depend on the cutoff. Returns a copy of `coulomb` with `alpha`, `cutoff`
+         * and `kcutoff` set and with results added to `autotune`.
+         */
+        template<class Tspace>
+            json tuneEwald(const json &coulomb, Tspace &spc, double skin=-1) {
+                if (coulomb.at("type")!="ewald")
+                    throw std::runtime_error("autotune requires coulomb type 'ewald'");
+                json out = coulomb;
+                double tolerance = coulomb.at("autotune").at("tolerance");
+                if (tolerance<=0)
+                    throw std::runtime_error("autotune tolerance must be positive");
+
+                double lB = pc::lB( coulomb.at("epsr") );
+                double Q = 0; // sum of squared charges
+                size_t N = 0;
+                for (auto &g : spc.groups)
+                    for (auto &i : g) {
+                        Q += i.charge * i.charge;
+                        N++;
+                    }
+                Point L = spc.geo.getLength();
+                double V = spc.geo.getVolume();
+                double rcmax = 0.5*L.minCoeff();
+                bool ipbc = coulomb.value("ipbc", false);
+                bool spherical = coulomb.value("spherical_sum", true);
+                double target = tolerance / std::sqrt(2.0);
+
+                auto realError = [&](double alpha, double rc) {
+                    return lB * Q * std::sqrt(rc/(2*V)) * std::exp(-alpha*alpha*rc*rc) / (alpha*alpha*rc*rc);
+                };
+                auto reciprocalError = [&](double alpha, int kc) {
+                    return lB * Q * alpha / (pc::pi*pc::pi) * std::pow(kc, -1.5)
+                        * std::exp( -std::pow(pc::pi*kc / (alpha*L.maxCoeff()), 2) );
+                };
+                auto numberOfKVectors = [&](int kc) {
+                    double n = spherical ? 4*pc::pi/3*std::pow(kc,3) : std::pow(2*kc+1,3);
+                    return ipbc ? n/8 : n/2;
+                };
+                auto seconds = [](auto f) {
+                    int n=0;
+                    auto t0 = std::chrono::steady_clock::now();
+                    double t;
+                    do {
+                        f();
+                        n++;
+                        t = std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+                    } while (t<0.02);
+                    return t/n;
+                }; // average time per call
+
+                // time per k-vector and particle for structure factors
+                json trial = coulomb;
+                trial["alpha"] = 4/rcmax;
+                trial["cutoff"] = rcmax;
+                trial["kcutoff"] = 5;
+                EwaldData data = trial;
+                data.update(L);
+                double tk;
+                if (coulomb.value("policy", "default")=="recurrence") {
+                    PolicyIonIonRecurrence<Tspace> policy(spc);
+                    tk = seconds( [&]() { policy.updateComplex(data); } );
+                } else {
+                    PolicyIonIon<Tspace> policy(spc);
+                    tk = seconds( [&]() { policy.updateComplex(data); } );
+                }
+                tk /= data.kVectors.cols() * std::max(N, size_t(1));
+
+                // time per pair for the real-space potential
+                trial.erase("autotune");
+                Potential::CoulombGalore pot;
+                pot.from_json(trial);
+                volatile double sum = 0;
+                double dr = rcmax / 20;
+                double tpair = seconds( [&]() {
+                        for (int i=0; i<1000; i++)
+                            sum += pot(0, 0, 1.0, -1.0, std::pow( dr*(1 + i%20), 2 ));
+                        } ) / 1000;
+
+                double costmin = pc::infty;
+                for (int n=0; n<=100; n++) {
+                    double alpha = std::pow(10, n/50.0) / rcmax; // 1/rcmax ... 100/rcmax
+                    if (realError(alpha, rcmax) > target)
+                        continue;
+                    double lo=0.01*rcmax, hi=rcmax; // smallest real-space cutoff
+                    for (int i=0; i<50; i++) {
+                        double rc = 0.5*(lo+hi);
+                        if (realError(alpha, rc) > target)
+                            lo = rc;
+                        else
+                            hi = rc;
+                    }
+                    int kc=1; // smallest reciprocal cutoff
+                    while (kc<=100 && reciprocalError(alpha, kc) > target)
+                        kc++;
+                    if (kc>100)
+                        continue;
+                    double pairs = (skin<0) ? N : N/V * 4*pc::pi/3 * std::pow(hi+skin, 3);
+                    double cost = tpair*pairs + tk*2*numberOfKVectors(kc); // single particle move
+                    if (cost<costmin) {
+                        costmin = cost;
+                        out["alpha"] = alpha;
+                        out["cutoff"] = hi;
+                        out["kcutoff"] = kc;
+                        out["autotune"]["error"] = { {"real", realError(alpha, hi)}, {"reciprocal", reciprocalError(alpha, kc)} };
+                    }
+                }
+                if (costmin==pc::infty)
+                    throw std::runtime_error("autotune: tolerance cannot be reached; increase box size or tolerance");
+                out["autotune"]["time/pair (ns)"] = tpair*1e9;
+                out["autotune"]["time/kvector (ns)"] = tk*1e9;
+                out["autotune"]["time/move (μs)"] = costmin*1e6;
+                return out;
+            }
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+        TEST_CASE("[Faunus] Ewald - autotune")
+        {
+            typedef Space<Geometry::Cuboid, Particle<Charge>> Tspace;
+            Tspace spc;
+            spc.geo = R"( {"length": 30} )"_json;
+            spc.p.resize(50);
+            for (size_t i=0; i<spc.p.size(); i++) {
+                spc.p[i].pos = Point(0.37*i, 0.53*i, -0.71*i);
+                spc.geo.boundary( spc.p[i].pos );
+                spc.p[i].charge = (i%2) ? -1 : 1;
+            }
+            spc.groups.push_back( typename Tspace::Tgroup(spc.p.begin(), spc.p.end()) );
+
+            json j = R"({"type": "ewald", "epsr": 80, "autotune": {"tolerance": 0.001}})"_json;
+            json tight = tuneEwald(j, spc);
+            CHECK( tight.at("cutoff").get<double>() <= 15 );
+            CHECK( tight["autotune"]["error"]["real"].get<double>() < 0.001 );
+            CHECK( tight["autotune"]["error"]["reciprocal"].get<double>() < 0.001 );
+
+            j["autotune"]["tolerance"] = 0.1;
+            json loose = tuneEwald(j, spc);
+            CHECK( loose.at("kcutoff").get<int>() <= tight.at("kcutoff").get<int>() );
+
+            j["autotune"]["tolerance"] = 0;
+            CHECK_THROWS( tuneEwald(j, spc) );
+            j["type"] = "plain";
+            CHECK_THROWS( tuneEwald(j, spc) );
+        }
+#endif
+
+        /** @brief Adds dipolar Ewald term if particles have dipoles */
+        template<class Tspace, class Enable = void>
+            struct EwaldIonDip {
+                static void add(BasePointerVector<Energybase>&, const json&, Tspace&) {
+                    throw std::runtime_error("ewald policy 'iondip' requires particles with dipoles");
+                }
+            }; // primary template
+
+        /** @brief Adds dipolar Ewald term if particles have dipoles */
+        template<class Tspace>
+            struct EwaldIonDip<Tspace, typename std::enable_if<std::is_base_of<Dipole, typename Tspace::Tparticle>::value>::type> {
+                static void add(BasePointerVector<Energybase> &vec, const json &j, Tspace &spc) {
+                    vec.push_back<Ewald<Tspace,PolicyIonDip<Tspace>>>(j, spc);
+                }
+            }; // specialized template
+
+        /**
+         * @brief Smooth particle mesh Ewald reciprocal energy
+         *
+         * Same energy as `Ewald` but with charges assigned to a mesh so that
+         * the full energy is obtained in O(N log N) via fast Fourier transforms.
+         * Trial moves of a few particles update the transformed mesh charges
+         * directly, see `ParticleMesh`. Surface and self energies are kept
+         * up to date with the changed particles only.
+         */
+        template<class Tspace>
+            class EwaldPME : public Energybase {
+                private:
+                    Tspace& spc;
+                    Tspace *old=nullptr; // set only if key==NEW at first call to `sync()`
+                    ParticleMesh mesh;
+                    double alpha, lB, eps_surf, const_inf, spacing=0;
+                    double urec=0, qq=0; // reciprocal energy and sum of squared charges
+                    Point mu={0,0,0};    // sum of charges times positions
+                    enum updates {NOUPDATE, PARTIAL, FULL};
+                    updates updated=NOUPDATE; // mesh update since last sync; a partial update can be undone or repeated
+                    std::vector<Point> pos;
+                    std::vector<double> charge;
+
+                    void updateAll() {
+                        mesh.setBox( spc.geo.getLength() );
+                        qq = 0;
+                        mu.setZero();
+                        for (auto &g : spc.groups)
+                            for (auto &i : g) {
+                                mesh.add(i.pos, i.charge);
+                                qq += i.charge * i.charge;
+                                mu += i.charge * i.pos;
+                            }
+                        urec = mesh.update();
+                        updated = FULL;
+                    } //!< Calculate everything from scratch
+
+                    void updateChange(Change &change) {
+                        pos.clear();
+                        charge.clear(); // negative charges remove old contributions
+                        forEachChangedParticle(spc, *old, change, [&](const typename Tspace::Tparticle &p, double sign) {
+                                if (p.charge==0)
+                                    return;
+                                pos.push_back( p.pos );
+                                charge.push_back( sign*p.charge );
+                                qq += sign * p.charge * p.charge;
+                                mu += sign * p.charge * p.pos;
+                                } );
+                        if (pos.empty())
+                            return;
+                        if (pos.size() > std::log2(mesh.size())) // cheaper to start over
+                            return updateAll();
+                        urec += mesh.change(pos, charge);
+                        updated = PARTIAL;
+                    } //!< Update from changed particles only
+
+                    double selfEnergy() const {
+                        return -alpha*qq / std::sqrt(pc::pi) * lB;
+                    }
+
+                    double surfaceEnergy() const {
+                        if (const_inf < 0.5)
+                            return 0;
+                        return const_inf * 2 * pc::pi / ( (2*eps_surf+1) * spc.geo.getVolume() ) * mu.dot(mu) * lB;
+                    }
+
+                public:
+                    EwaldPME(const json &j, Tspace &spc) : spc(spc) {
+                        name = "ewald_pme";
+                        cite = "doi:10/fp6h9j";
+                        fused = true;
+                        if (j.value("ipbc", false))
+                            throw std::runtime_error("ewald_pme: ipbc is not supported");
+                        alpha = j.at("alpha");
+                        lB = pc::lB( j.at("epsr") );
+                        eps_surf = j.value("epss", 0.0);
+                        const_inf = (eps_surf < 1) ? 0 : 1; // if unphysical (<1) use epsr infinity for surrounding medium
+
+                        std::array<int,3> K;
+                        Point L = spc.geo.getLength();
+                        if (j.count("mesh")==1) {
+                            if (j["mesh"].is_number())
+                                K.fill( j["mesh"].get<int>() );
+                            else
+                                K = j["mesh"].get<std::array<int,3>>();
+                        } else {
+                            spacing = j.value("spacing", 1.0);
+                            for (int d=0; d<3; d++) { // smallest power of two giving at most `spacing`
+                                K[d] = 1;
+                                while (K[d] < L[d]/spacing)
+                                    K[d] *= 2;
+                            }
+                        }
+                        mesh.resize(K, j.value("order", 4), alpha, lB);
+                        init();
+                    }
+
+                    void init() override {
+                        updateAll();
+                    }
+
+                    double energy(Change &change) override {
+                        if (change.empty())
+                            return 0;
+                        if (key==NEW) {
+                            if (change.all || change.dV || old==nullptr)
+                                updateAll();
+                            else
+                                updateChange(change);
+                        }
+                        return urec + selfEnergy() + surfaceEnergy();
+                    }
+
+                    void sync(Energybase *basePtr, Change &change) override {
+                        auto other = dynamic_cast<decltype(this)>(basePtr);
+                        assert(other);
+                        if (other->key==OLD)
+                            old = &(other->spc); // give NEW access to OLD space for optimized updates
+                        auto trial = (other->key==OLD) ? updated : other->updated; // mesh update of NEW
+                        if (change.all || change.dV)
+                            mesh = other->mesh; // copy everything!
+                        else if (trial==FULL)
+                            mesh.sync(other->mesh);
+                        else if (trial==PARTIAL) {
+                            if (other->key==OLD)
+                                mesh.revert(); // rejected: undo trial change
+                            else
+                                mesh.apply(other->mesh); // accepted: repeat trial change
+                        } // else meshes are identical
+                        updated = other->updated = NOUPDATE;
+                        urec = other->urec;
+                        qq = other->qq;
+                        mu = other->mu;
+                    } //!< Called after a move is rejected/accepted as well as before simulation
+
+                    void to_json(json &j) const override {
+                        j = {{"lB", lB}, {"epss", eps_surf}, {"alpha", alpha},
+                            {"mesh", mesh.mesh()}, {"order", mesh.splineOrder()}};
+                        if (spacing>0)
+                            j["spacing"] = spacing;
+                    }
+            };
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+        TEST_CASE("[Faunus] Ewald - particle mesh")
+        {
+            using doctest::Approx;
+            typedef Space<Geometry::Cuboid, Particle<Charge>> Tspace;
+
+            Tspace spc, old;
+            for (Tspace *s : {&spc, &old}) {
+                s->geo = R"( {"length": [10,12,14]} )"_json;
+                s->p.resize(10);
+                for (size_t i=0; i<s->p.size(); i++) {
+                    s->p[i].pos = Point(0.9*i, 0.5*i, -1.3*i) - Point(4,2,-6);
+                    s->p[i].charge = (i%2) ? -1 : 1;
+                }
+                s->groups.push_back( typename Tspace::Tgroup(s->p.begin(), s->p.end()) );
+                s->groups.back().atomic = true;
+            }
+            json j = R"({ "epsr": 1.0, "alpha": 0.6, "epss": 1.0, "cutoff": 5.0,
+                "kcutoff": 12.0, "spherical_sum": false, "spacing": 0.5, "order": 6 })"_json;
+
+            Ewald<Tspace> ewald(j, spc); // reference
+            EwaldPME<Tspace> pme(j, spc), pmeold(j, old);
+            pme.key = Energybase::NEW;
+            pmeold.key = Energybase::OLD;
+
+            json je, jp; // Bjerrum length depends on the temperature in the compilation unit
+            ewald.to_json(je);
+            pme.to_json(jp);
+            double scale = jp["lB"].get<double>() / je["lB"].get<double>();
+
+            Change c;
+            c.all = true;
+            ewald.key = Energybase::NEW;
+            CHECK( pme.energy(c) == Approx( scale*ewald.energy(c) ).epsilon(1e-4) );
+            pme.sync(&pmeold, c);
+
+            c.all = false; // move single particle
+            c.groups.resize(1);
+            c.groups[0].index = 0;
+            c.groups[0].atoms = {3};
+            spc.p[3].pos = Point(1,-1,2);
+            double u = pme.energy(c);
+            CHECK( u == Approx( scale*ewald.energy(c) ).epsilon(1e-4) );
+            Change all;
+            all.all = true;
+            EwaldPME<Tspace> ref(j, spc);
+            ref.key = Energybase::NEW;
+            CHECK( u == Approx( ref.energy(all) ) );
+
+            pme.sync(&pmeold, c); // reject
+            spc.p = old.p;
+            CHECK( pme.energy(c) == Approx( pmeold.energy(c) ) );
+
+            spc.p[4].charge = -0.5; // charge change
+            c.groups[0].atoms = {4};
+            u = pme.energy(c);
+            CHECK( u == Approx( ref.energy(all) ) );
+        }
+
+        TEST_CASE("[Faunus] Ewald - group cache")
+        {
+            using doctest::Approx;
+            typedef Space<Geometry::Cuboid, Particle<Charge>> Tspace;
+
+            Tspace spc, old;
+            for (Tspace *s : {&spc, &old}) {
+                s->geo = R"( {"length": [10,12,14]} )"_json;
+                s->p.resize(20);
+                for (size_t i=0; i<s->p.size(); i++) {
+                    s->p[i].pos = Point(0.9*i, 0.5*i, -1.3*i) - Point(4,2,-6);
+                    s->geo.boundary( s->p[i].pos );
+                    s->p[i].charge = (i%3) ? -0.5 : 1;
+                }
+                for (int i=0; i<4; i++) // four molecules with five particles each
+                    s->groups.push_back( typename Tspace::Tgroup(s->p.begin()+5*i, s->p.begin()+5*i+5) );
+            }
+            json j = R"({ "epsr": 1.0, "alpha": 0.6, "epss": 1.0, "cutoff": 5.0,
+                "kcutoff": 7.0, "spherical_sum": true, "groupcache": true })"_json;
+
+            Ewald<Tspace> ewald(j, spc), ewaldold(j, old);
+            ewald.key = Energybase::NEW;
+            ewaldold.key = Energybase::OLD;
+            Change all;
+            all.all = true;
+            ewald.sync(&ewaldold, all);
+
+            auto reference = [&]() {
+                Ewald<Tspace> ref(R"({ "epsr": 1.0, "alpha": 0.6, "epss": 1.0, "cutoff": 5.0,
+                    "kcutoff": 7.0, "spherical_sum": true })"_json, spc);
+                ref.key = Energybase::NEW;
+                return ref.energy(all);
+            };
+
+            Change c; // translate molecule across the boundary
+            c.groups.resize(1);
+            c.groups[0].index = 1;
+            c.groups[0].all = true;
+            spc.groups[1].translate( Point(3.1,-7.4,5.2), spc.geo.boundaryFunc );
+            double u = ewald.energy(c);
+            CHECK( u == Approx( reference() ) );
+            ewaldold.sync(&ewald, c); // accept
+            old.p = spc.p;
+
+            c.groups[0].index = 2; // move single particle
+            c.groups[0].all = false;
+            c.groups[0].atoms = {1};
+            (spc.groups[2].begin()+1)->pos = Point(1,-1,2);
+            CHECK( ewald.energy(c) == Approx( reference() ) );
+            ewald.sync(&ewaldold, c); // reject
+            spc.p = old.p;
+            CHECK( ewald.energy(c) == Approx(u) );
+
+            c.groups[0].all = true; // translate again after rejection
+            spc.groups[2].translate( Point(-0.4,0.2,1.1), spc.geo.boundaryFunc );
+            CHECK( ewald.energy(c) == Approx( reference() ) );
+        }
+#endif
+
         template<typename Tspace>
             class Isobaric : public Energybase {
                 private:
@@ -264,6 +1352,8 @@ namespace Faunus {
                     Isobaric(const json &j, Tspace &spc) : spc(spc) {
                         name = "isobaric";
                         cite = "Frenkel & Smith 2nd Ed (Eq. 5.4.13)";
+                        fused = true;
+                        journal = true;
                         P = j.value("P/mM", 0.0) * 1.0_mM;
                         if (P<1e-10) {
                             P = j.value("P/Pa", 0.0) * 1.0_Pa;
@@ -333,6 +1423,8 @@ namespace Faunus {
                 public:
                     ExternalPotential(const json &j, Tspace &spc) : spc(spc) {
                         name="external";
+                        fused = true;
+                        journal = true;
                         COM = j.value("com", false);
                         _names = j.at("molecules").get<decltype(_names)>(); // molecule names
                         auto _ids = names2ids(molecules<Tpvec>, _names);     // names --> molids
@@ -433,6 +1525,9 @@ namespace Faunus {
                                 return 0.5*k*u;
                             };
                         }
+                        if (k>=0)
+                            base::umin = 0; // confinement never lowers the energy
+                        base::journal = !scale; // scaled radius is not recorded
                     }
 
                     void to_json(json &j) const override {
@@ -497,6 +1592,8 @@ namespace Faunus {
                 public:
                     Bonded(const json &j, Tspace &spc) : spc(spc) {
                         name = "bonded";
+                        fused = true;
+                        journal = true;
                         update();
                         if (j.is_object())
                             if (j.count("bondlist")==1)
@@ -543,13 +1640,140 @@ namespace Faunus {
                     double g2gcnt=0, g2gskip=0;
                 protected:
                     typedef typename Tspace::Tgroup Tgroup;
+                    typedef typename Tspace::Tparticle Tparticle;
+                    typedef Potential::hasKernel<Tpairpot> Tkernel; // true if structure-of-arrays kernel can be used
                     double Rc2_g2g=pc::infty;
+                    Point L, Lhalf; // box length; Lhalf is infinite in non-periodic directions
 
                     void to_json(json &j) const override {
                         j["pairpot"] = pairpot;
                         j["cutoff_g2g"] = std::sqrt(Rc2_g2g);
+                        if (!sites.linear)
+                            j["fixed sites"] = "not tabulated; pair potential is not linear in charges";
+                        else if (sites.n>0)
+                            j["fixed sites"] = sites.n;
                     }
 
+                    void updateBox() {
+                        L = spc.geo.getLength();
+                        Point r = spc.geo.vdist(Point::Zero(), 0.75*L); // periodic dimensions are wrapped
+                        for (int d=0; d<3; d++)
+                            Lhalf[d] = (std::fabs(r[d]) < 0.5*L[d]) ? 0.5*L[d] : pc::infty;
+                    } //!< Update box information used by kernels
+
+                    inline bool overlap(double u) const {
+                        return earlyexit && u==pc::infty;
+                    } //!< True if summation can stop due to an infinite energy, i.e. an overlap
+
+                    /*
+                     * Energy of particle `a` with particles in the index range [first,last)
+                     * of the particle vector. The generic version calls `i2i()` for each pair
+                     * while the kernel version streams through the particle arrays of Space,
+                     * `Space::arrays()`. Distances and the pair potential, evaluated from
+                     * atom types, charges and squared distances only, are calculated in one
+                     * branchless loop that the compiler can vectorize. Overlaps are checked
+                     * between chunks.
+                     */
+                    template<typename T>
+                        inline double i2range(const T &a, int first, int last, std::false_type) {
+                            double u=0;
+                            for (int j=first; j<last; j++) {
+                                u += i2i(a, spc.p[j]);
+                                if (overlap(u))
+                                    break;
+                            }
+                            return u;
+                        }
+
+                    template<typename T>
+                        inline double i2range(const T &a, int first, int last, std::true_type) {
+                            constexpr int chunk=256;
+                            double u=0;
+                            const double ax=a.pos.x(), ay=a.pos.y(), az=a.pos.z(), qa=a.charge;
+                            const int ida=a.id;
+                            const double Lx=L.x(), Ly=L.y(), Lz=L.z(), hx=Lhalf.x(), hy=Lhalf.y(), hz=Lhalf.z();
+                            const auto &pot = pairpot;
+                            auto &s = spc.arrays();
+                            constexpr int S = std::decay_t<decltype(s)>::stride;
+                            assert(s.size()==spc.p.size());
+                            for (int k=first; k<last; k+=chunk) {
+                                const int n = std::min(chunk, last-k);
+                                const double *x=s.coordinates(0)+S*k, *y=s.coordinates(1)+S*k, *z=s.coordinates(2)+S*k;
+                                const double *q=s.charges()+k;
+                                const int *id=s.ids()+k;
+#pragma omp simd reduction(+:u)
+                                for (int l=0; l<n; l++) {
+                                    double dx=ax-x[S*l], dy=ay-y[S*l], dz=az-z[S*l];
+                                    dx -= (dx>hx) ? Lx : 0;
+                                    dx += (dx<-hx) ? Lx : 0;
+                                    dy -= (dy>hy) ? Ly : 0;
+                                    dy += (dy<-hy) ? Ly : 0;
+                                    dz -= (dz>hz) ? Lz : 0;
+                                    dz += (dz<-hz) ? Lz : 0;
+                                    u += pot(ida, id[l], qa, q[l], dx*dx + dy*dy + dz*dz);
+                                }
+                                if (overlap(u))
+                                    break;
+                            }
+                            return u;
+                        }
+
+                    /*
+                     * Energy change when particle `a` replaces `aold` (its copy in the old state)
+                     * against the static particles in the range [first,last). Both distances are
+                     * calculated in the same pass over the partners.
+                     */
+                    template<typename T>
+                        inline double i2range(const T &a, const T &aold, int first, int last, std::false_type) {
+                            double du=0;
+                            for (int j=first; j<last; j++)
+                                du += i2i(a, spc.p[j]) - i2i(aold, spc.p[j]);
+                            return du;
+                        }
+
+                    template<typename T>
+                        inline double i2range(const T &a, const T &aold, int first, int last, std::true_type) {
+                            double du=0;
+                            const double ax=a.pos.x(), ay=a.pos.y(), az=a.pos.z(), qa=a.charge;
+                            const double bx=aold.pos.x(), by=aold.pos.y(), bz=aold.pos.z(), qb=aold.charge;
+                            const int ida=a.id, idb=aold.id;
+                            const double Lx=L.x(), Ly=L.y(), Lz=L.z(), hx=Lhalf.x(), hy=Lhalf.y(), hz=Lhalf.z();
+                            const auto &pot = pairpot;
+                            auto &s = spc.arrays();
+                            constexpr int S = std::decay_t<decltype(s)>::stride;
+                            assert(s.size()==spc.p.size());
+                            const int n = last-first;
+                            const double *x=s.coordinates(0)+S*first, *y=s.coordinates(1)+S*first, *z=s.coordinates(2)+S*first;
+                            const double *q=s.charges()+first;
+                            const int *id=s.ids()+first;
+#pragma omp simd reduction(+:du)
+                            for (int l=0; l<n; l++) {
+                                double dx=ax-x[S*l], dy=ay-y[S*l], dz=az-z[S*l];
+                                double ex=bx-x[S*l], ey=by-y[S*l], ez=bz-z[S*l];
+                                dx -= (dx>hx) ? Lx : 0;
+                                dx += (dx<-hx) ? Lx : 0;
+                                dy -= (dy>hy) ? Ly : 0;
+                                dy += (dy<-hy) ? Ly : 0;
+                                dz -= (dz>hz) ? Lz : 0;
+                                dz += (dz<-hz) ? Lz : 0;
+                                ex -= (ex>hx) ? Lx : 0;
+                                ex += (ex<-hx) ? Lx : 0;
+                                ey -= (ey>hy) ? Ly : 0;
+                                ey += (ey<-hy) ? Ly : 0;
+                                ez -= (ez>hz) ? Lz : 0;
+                                ez += (ez<-hz) ? Lz : 0;
+                                du += pot(ida, id[l], qa, q[l], dx*dx + dy*dy + dz*dz)
+                                    - pot(idb, id[l], qb, q[l], ex*ex + ey*ey + ez*ez);
+                            }
+                            return du;
+                        }
+
+                    template<typename T>
+                        inline double i2g(const T &a, const Tgroup &g) {
+                            int first = g.begin()-spc.p.begin();
+                            return i2range(a, first, first+g.size(), Tkernel());
+                        } //!< Energy of particle with all active particles in group
+
                     template<typename T>
                         inline bool cut(const T &g1, const T &g2) {
                             g2gcnt++;
@@ -561,11 +1785,14 @@ namespace Faunus {
                             return true;
                         } //!< true if group<->group interaction can be skipped
 
-                    template<typename T>
-                        inline double i2i(const T &a, const T &b) {
-                            assert(&a!=&b && "a and b cannot be the same particle");
-                            return pairpot(a, b, spc.geo.vdist(a.pos, b.pos));
-                        }
+                    inline double i2i(const Tparticle &a, const Tparticle &b) {
+                        assert(&a!=&b && "a and b cannot be the same particle");
+                        return pairpot(a, b, spc.geo.vdist(a.pos, b.pos));
+                    } // proxies of structure-of-arrays storage are converted
+
+                    inline double electrostatic(const Tparticle &a, const Tparticle &b, const Point &r) const {
+                        return Potential::electrostatic(pairpot, a, b, r);
+                    } //!< Charge dependent part of the pair potential
 
                     /*
                      * Internal energy in group, calculating all with all or, if `index`
@@ -599,26 +1826,201 @@ namespace Faunus {
 
 
                     /*
-                     * Calculates the interaction energy of a particle, `i`,
-                     * and checks (1) if it is already part of Space, or (2)
-                     * external to space.
+                     * Work unit for parallel evaluation of all energies. A tile covers the atoms
+                     * [first,last) of a group and is either (1) their internal energy with all
+                     * following atoms in the group, or (2) their energy with all groups of
+                     * higher index. Tile sizes depend on group sizes only, and partial
+                     * sums are added in tile order so that results do not depend on the
+                     * number of threads.
+                     */
+                    struct Tile {
+                        int group, first, last;
+                        bool internal;
+                    };
+                    std::vector<Tile> tiles;
+                    std::vector<std::vector<int>> tileindex; // atom index of each partial group-to-group tile; kept between calls
+                    std::vector<double> partial; // energy of each tile
+                    std::vector<int> moved, ifiltered, jfiltered; // scratch space for `energy()`
+                    int blocksize=128; // number of atoms in group-to-group tiles; squared for internal tiles
+
+                    double tile(size_t k) {
+                        const Tile &t = tiles[k];
+                        double u=0;
+                        auto &g = spc.groups[t.group];
+                        int offset = g.begin()-spc.p.begin();
+                        if (t.internal)
+                            for (int i=t.first; i<t.last; i++)
+                                u += i2range( spc.p[offset+i], offset+i+1, offset+g.size(), Tkernel() );
+                        else if (t.last-t.first == int(g.size())) // entire group
+                            spc.forEachGroupNear(t.group, [&](int j) {
+                                    if (j>t.group)
+                                        u += g2g(g, spc.groups[j]);
+                                    });
+                        else
+                            spc.forEachGroupNear(t.group, [&](int j) {
+                                    if (j>t.group)
+                                        u += g2g(g, spc.groups[j], tileindex[k]);
+                                    });
+                        return u;
+                    } //!< Energy of a single tile
+
+                    /*
+                     * Couplings between particles in molecules that are never displaced, i.e.
+                     * `fixed` in the topology or immobile in the simulation (`Space::isFixed()`).
+                     * If the pair potential has the form u0(r) + q_i*q_j*w(r), u0 and w are
+                     * tabulated once for all pairs of such sites so that charge-only changes need no
+                     * distances. Pairs of molecules beyond `cutoff_g2g` are stored as zero. The
+                     * table is packed in single precision and is rebuilt when a fixed molecule is
+                     * changed in any other way, or when the volume changes.
+                     */
+                    struct SiteCoupling {
+                        std::vector<int> site;    // site index of each particle; -1 if not in a fixed molecule
+                        std::vector<int> index;   // particle index of each site
+                        std::vector<int> other;   // index of groups that are not fixed molecules
+                        std::vector<float> u0, w; // packed upper triangles
+                        size_t n=0;               // number of sites
+                        bool valid=false;         // false if the table must be rebuilt before use
+                        bool linear=true;         // false if the potential is not of the above form
+
+                        inline size_t pair(size_t i, size_t j) const {
+                            if (i>j)
+                                std::swap(i,j);
+                            return i*(2*n-i-1)/2 + j-i-1;
+                        }
+                    } sites;
+                    std::vector<char> changedmask; // marks the changed particles of a charge move; kept cleared
+                    std::vector<int> changedatoms; // particle index of the changed particles of a charge move
+
+                    bool tabulateSites(const std::vector<int> &group) {
+                        sites.u0.resize( sites.n*(sites.n-1)/2 );
+                        sites.w.resize( sites.n*(sites.n-1)/2 );
+                        for (size_t i=0; i<sites.n; i++)
+                            for (size_t j=i+1; j<sites.n; j++) {
+                                size_t k = sites.pair(i,j);
+                                auto &g1 = spc.groups[group[i]], &g2 = spc.groups[group[j]];
+                                if (group[i]!=group[j] && spc.geo.sqdist(g1.cm, g2.cm)>=Rc2_g2g) {
+                                    sites.u0[k] = sites.w[k] = 0; // see `cut()`
+                                    continue;
+                                }
+                                Tparticle a = spc.p[sites.index[i]], b = spc.p[sites.index[j]];
+                                Point r = spc.geo.vdist(a.pos, b.pos);
+                                a.charge = b.charge = 0;
+                                double u0 = pairpot(a, b, r);
+                                a.charge = b.charge = 1;
+                                double w = Potential::electrostatic(pairpot, a, b, r);
+                                double u1 = pairpot(a, b, r);
+                                a.charge = 2;
+                                if (std::fabs( Potential::electrostatic(pairpot, a, b, r) - 2*w ) > 1e-6*std::fabs(w)
+                                        || std::fabs( u1 - u0 - w ) > 1e-6*(std::fabs(u0) + std::fabs(w)))
+                                    return false; // not linear in charges
+                                sites.u0[k] = u0;
+                                sites.w[k] = w;
+                            }
+                        return true;
+                    }
+
+                    void updateSites() {
+                        std::vector<int> group; // group index of each site
+                        sites.site.assign(spc.p.size(), -1);
+                        sites.index.clear();
+                        sites.other.clear();
+                        for (int k=0; k<(int)spc.groups.size(); k++) {
+                            auto &g = spc.groups[k];
+                            if (!g.atomic && spc.isFixed(g.id))
+                                for (int j=g.begin()-spc.p.begin(); j<g.end()-spc.p.begin(); j++) {
+                                    sites.site[j] = sites.index.size();
+                                    sites.index.push_back(j);
+                                    group.push_back(k);
+                                }
+                            else
+                                sites.other.push_back(k);
+                        }
+                        sites.n = sites.index.size();
+                        sites.linear = tabulateSites(group);
+                        if (!sites.linear) { // use pair potential for all
+                            sites.site.assign(spc.p.size(), -1);
+                            sites.index.clear();
+                            sites.u0.clear();
+                            sites.w.clear();
+                            sites.n = 0;
+                        }
+                        changedmask.assign(spc.p.size(), 0);
+                        sites.valid = true;
+                    } //!< Tabulate couplings between sites in fixed molecules (complexity: order N_sites^2)
+
+                    bool isSite(const Tgroup &g) const {
+                        size_t first = g.begin()-spc.p.begin();
+                        return !g.empty() && first<sites.site.size() && sites.site[first]>=0;
+                    } //!< True if group is a fixed molecule with tabulated couplings
+
+                    bool useSites(const Change::data &d) {
+                        auto &g = spc.groups[d.index];
+                        if (!d.charge || g.atomic || !spc.isFixed(g.id))
+                            return false;
+                        if (!sites.valid)
+                            updateSites();
+                        if (!isSite(g))
+                            return false;
+                        int offset = g.begin()-spc.p.begin();
+                        changedatoms.clear();
+                        if (d.all || d.atoms.empty())
+                            for (int i=0; i<(int)g.size(); i++)
+                                changedatoms.push_back(offset+i);
+                        else
+                            for (int i : d.atoms)
+                                if (i<(int)g.size())
+                                    changedatoms.push_back(offset+i);
+                        return true;
+                    } //!< True if the tabulated couplings apply to a change; sets `changedatoms`
+
+                    /*
+                     * Energy of the changed sites, `changedatoms`, with all other particles: tabulated
+                     * for sites and from the pair potential for particles in the other groups. Pairs
+                     * of changed sites are counted once.
+                     */
+                    double siteEnergy(const Tgroup &g) {
+                        double u=0;
+                        for (int i : changedatoms)
+                            changedmask[i] = 1;
+                        for (int i : changedatoms) {
+                            auto &&a = spc.p[i];
+                            size_t si = sites.site[i];
+                            for (int j : sites.index)
+                                if (j!=i && !(changedmask[j] && j<i)) {
+                                    size_t k = sites.pair(si, sites.site[j]);
+                                    u += sites.u0[k] + a.charge*spc.p[j].charge*sites.w[k];
+                                }
+                            for (int k : sites.other)
+                                if (!cut(spc.groups[k], g))
+                                    u += i2g(a, spc.groups[k]);
+                            if (overlap(u))
+                                break;
+                        }
+                        for (int i : changedatoms)
+                            changedmask[i] = 0;
+                        return u;
+                    }
+
+                    /*
+                     * Calculates the interaction energy of the particle with index `self`
+                     * and checks (1) if it is part of an active group, or (2) not.
                      */
-                    double i2all(const typename Tspace::Tparticle &i) {
+                    double i2all(size_t self) {
                         double u=0;
-                        auto it = spc.findGroupContaining(i); // iterator to group
+                        auto &&i = spc.p[self];
+                        auto it = spc.findGroupContaining(self); // iterator to group
                         if (it!=spc.groups.end()) {    // check if i belongs to group in space
-                            for (auto &g : spc.groups) // i with all other particles
-                                if (&g!=&(*it))        // avoid self-interaction
-                                    if (!cut(g, *it))  // check g2g cut-off
-                                        for (auto &j : g) // loop over particles in other group
-                                            u += i2i(i,j);
-                            for (auto &j : *it)        // i with all particles in own group
-                                if (&j!=&i)
-                                    u += i2i(i,j);
+                            spc.forEachGroupNear( it-spc.groups.begin(), [&](int k) { // i with all other particles
+                                    auto &g = spc.groups[k];
+                                    if (!cut(g, *it) && !overlap(u))  // check g2g cut-off
+                                        u += i2g(i, g); // loop over particles in other group
+                                    });
+                            int first = it->begin()-spc.p.begin(); // i with all particles in own group
+                            if (!overlap(u))
+                                u += i2range(i, first, self, Tkernel()) + i2range(i, self+1, first+it->size(), Tkernel());
                         } else // particle does not belong to any group
                             for (auto &g : spc.groups) // i with all other *active* particles
-                                for (auto &j : g)      // (this will include only active particles)
-                                    u += i2i(i,j);
+                                u += i2g(i, g);        // (this will include only active particles)
                         return u;
                     }
 
@@ -635,15 +2037,17 @@ namespace Faunus {
                     double u = 0;
                         if (!cut(g1,g2)) {
                             if ( index.empty() && jndex.empty() ) // if index is empty, assume all in g1 have changed
-                                for (auto &i : g1)
-                                    for (auto &j : g2) {
-                                        u += i2i(i,j);
-                                    }
+                                for (auto &&i : g1) {
+                                    u += i2g(i, g2);
+                                    if (overlap(u))
+                                        break;
+                                }
                             else {// only a subset of g1
-                                for (auto i : index)
-                                    for (auto j=g2.begin(); j!=g2.end(); ++j) {
-                                        u += i2i( *(g1.begin()+i), *j);
-                                    }
+                                for (auto i : index) {
+                                    u += i2g( *(g1.begin()+i), g2);
+                                    if (overlap(u))
+                                        return u;
+                                }
                                 if ( !jndex.empty() ) {
                                     auto fixed = view::ints( 0, int(g1.size()) )
                                         | view::remove_if(
@@ -664,10 +2068,22 @@ namespace Faunus {
 
                     Nonbonded(const json &j, Tspace &spc) : spc(spc) {
                         name="nonbonded";
+                        fused=true;
+                        journal=true;
                         pairpot = j;
                         Rc2_g2g = std::pow( j.value("cutoff_g2g", pc::infty), 2);
+                        init();
                     }
 
+                    void init() override {
+                        sites.valid = false;
+                        if (Rc2_g2g<pc::infty)
+                            spc.updateMassCenterGrid( std::sqrt(Rc2_g2g) );
+                        if (Tkernel::value)
+                            spc.updateArrays();
+                        updateBox();
+                    } //!< Enable mass center grid and particle arrays in Space if needed
+
                     void force(std::vector<Point> &forces) override {
                         auto &p = spc.p; // alias to particle vector (reference)
                         assert(forces.size() == p.size() && "the forces size must match the particle size");
@@ -680,63 +2096,116 @@ namespace Faunus {
                             }
                     }
 
+                    void invalidateSites(const Change &change) {
+                        if (sites.valid) { // tabulated couplings remain valid only if fixed molecules are untouched
+                            if (change.dV || change.all || sites.site.size()!=spc.p.size())
+                                sites.valid = false;
+                            else
+                                for (auto &d : change.groups)
+                                    if (!d.charge && isSite(spc.groups[d.index]))
+                                        sites.valid = false;
+                        }
+                    }
+
+                    void sync(Energybase*, Change &change) override {
+                        invalidateSites(change);
+                    } //!< Positions may have been copied by `Space::sync()`
+
+                    void prepare(const Change &change) {
+                        invalidateSites(change);
+                        if (Rc2_g2g<pc::infty) { // keep mass center grid of trial state up-to-date
+                            if (spc.cmgridcutoff < std::sqrt(Rc2_g2g))
+                                spc.updateMassCenterGrid( std::sqrt(Rc2_g2g) );
+                            else
+                                spc.updateMassCenterGrid(change);
+                        }
+                        if (Tkernel::value) { // ...and so the particle arrays
+                            if (spc.soa.enabled)
+                                spc.updateArrays(change);
+                            else
+                                spc.updateArrays();
+                            updateBox(); // the geometry may have been synched
+                        }
+                    } //!< Update mass center grid and particle arrays before calculating energies
+
                     double energy(Change &change) override {
                         using namespace ranges;
                         double u=0;
 
                         if (!change.empty()) {
 
-                            if (change.dV) {
-#pragma omp parallel for reduction (+:u) schedule (dynamic)
-                                for ( auto i = spc.groups.begin(); i < spc.groups.end(); ++i ) {
-                                    for ( auto j=i; ++j != spc.groups.end(); )
-                                        u += g2g( *i, *j );
-                                    if (i->atomic)
-                                        u += g_internal(*i);
+                            prepare(change);
+
+                            // did everything change? Internal energy of molecules is unaffected by volume scaling
+                            if (change.dV || change.all) {
+                                tiles.clear();
+                                for (int i=0; i<(int)spc.groups.size(); i++) {
+                                    auto &g = spc.groups[i];
+                                    int n = g.size();
+                                    if (g.atomic && n>blocksize) // group-to-group in blocks of atoms...
+                                        for (int first=0; first<n; first+=blocksize)
+                                            tiles.push_back( {i, first, std::min(first+blocksize, n), false} );
+                                    else // ...or all atoms at once
+                                        tiles.push_back( {i, 0, n, false} );
+                                    if (change.all || g.atomic) // internal energy in blocks of rows
+                                        for (int first=0, pairs=0, i1=0; i1<n; i1++) {
+                                            pairs += n-i1-1;
+                                            if (pairs>=blocksize*blocksize || i1==n-1) {
+                                                tiles.push_back( {i, first, i1+1, true} );
+                                                first = i1+1;
+                                                pairs = 0;
+                                            }
+                                        }
                                 }
-                                return u;
-                            }
-
-                            // did everything change?
-                            if (change.all) {
-#pragma omp parallel for reduction (+:u) schedule (dynamic)
-                                for ( auto i = spc.groups.begin(); i < spc.groups.end(); ++i ) {
-                                    for ( auto j=i; ++j != spc.groups.end(); )
-                                        u += g2g( *i, *j );
-                                    u += g_internal(*i);
+                                tileindex.resize( tiles.size() ); // inner vectors keep their capacity
+                                for (size_t k=0; k<tiles.size(); k++) {
+                                    auto &t = tiles[k];
+                                    if (!t.internal && t.last-t.first < int(spc.groups[t.group].size())) {
+                                        tileindex[k].resize(t.last-t.first);
+                                        std::iota(tileindex[k].begin(), tileindex[k].end(), t.first);
+                                    }
                                 }
-                                // more todo here...
-                                return u;
+                                partial.resize( tiles.size() );
+                                executor.parallel_for(tiles.size(), [&](size_t first, size_t last) {
+                                        for (size_t k=first; k<last; k++)
+                                            partial[k] = tile(k);
+                                        } );
+                                return std::accumulate(partial.begin(), partial.end(), 0.0); // fixed summation order
                             }
 
                             // if exactly ONE molecule is changed
                             if (change.groups.size()==1 && !change.dNpart) {
                                 auto& d = change.groups[0];
+                                if (useSites(d)) // charges of a fixed molecule
+                                    return siteEnergy( spc.groups[d.index] );
                                 auto gindex = spc.groups.at(d.index).to_index(spc.p.begin()).first;
                                 if (d.atoms.size()==1) // exactly one atom has moved
-                                    return i2all(spc.p.at(gindex+d.atoms[0]));
+                                    return i2all(gindex+d.atoms[0]);
                                 auto& g1 = spc.groups.at(d.index);
-                                for (auto &g2 : spc.groups)
-                                    if (&g1 != &g2)
-                                        u += g2g(g1, g2, d.atoms);
-                                if (d.internal)
+                                spc.forEachGroupNear(d.index, [&](int j) {
+                                        if (!overlap(u))
+                                            u += g2g(g1, spc.groups[j], d.atoms);
+                                        });
+                                if (d.internal && !overlap(u))
                                     u += g_internal(g1, d.atoms);
                                 return u;
                             }
 
-                            //
+                            // particles in `atoms` beyond the group size are inactive and skipped; with
+                            // `ElasticRange::swapDeactivate()` the atoms list both the removed and the
+                            // swapped particle whose contributions cancel between the new and old state
                             if (change.dNpart) {
-                                auto moved = change.touchedGroupIndex(); // index of moved groups
-                                std::vector<int> Moved;
-                                for (auto i: moved)
-                                    Moved.push_back(i);
-                                std::sort( Moved.begin(), Moved.end() );
+                                moved.clear(); // index of moved groups
+                                for (auto i: change.touchedGroupIndex())
+                                    moved.push_back(i);
+                                std::sort( moved.begin(), moved.end() );
                                 auto fixed = view::ints( 0, int(spc.groups.size()) )
                                     | view::remove_if(
-                                            [&Moved](int i){return std::binary_search(Moved.begin(), Moved.end(), i);}
+                                            [&](int i){return std::binary_search(moved.begin(), moved.end(), i);}
                                             ); // index of static groups
                                 for ( auto cg1 = change.groups.begin(); cg1 < change.groups.end() ; ++cg1 ) { // Loop over all changed groups
-                                    std::vector<int> ifiltered, jfiltered;
+                                    ifiltered.clear();
+                                    jfiltered.clear();
                                     for (auto i: cg1->atoms) {
                                         if ( i < spc.groups.at(cg1->index).size() )
                                             ifiltered.push_back(i);
@@ -759,11 +2228,10 @@ namespace Faunus {
                                 return u;
                             }
 
-                            auto moved = change.touchedGroupIndex(); // index of moved groups
-                            auto fixed = view::ints( 0, int(spc.groups.size()) )
-                                | view::remove_if(
-                                        [&moved](int i){return std::binary_search(moved.begin(), moved.end(), i);}
-                                        ); // index of static groups
+                            moved.clear(); // index of moved groups
+                            for (auto i : change.touchedGroupIndex())
+                                moved.push_back(i);
+                            std::sort( moved.begin(), moved.end() );
 
                             // moved<->moved
                             for ( auto i = moved.begin(); i != moved.end(); ++i ) {
@@ -773,16 +2241,342 @@ namespace Faunus {
 
                             // moved<->static
                             for ( auto i : moved)
-                                for ( auto j : fixed)
-                                    u += g2g(spc.groups[i], spc.groups[j]);
+                                spc.forEachGroupNear(i, [&](int j) {
+                                        if (!std::binary_search(moved.begin(), moved.end(), j) && !overlap(u))
+                                            u += g2g(spc.groups[i], spc.groups[j]);
+                                        });
 
                             // more todo!
                         }
                         return u;
                     }
 
+                    /*
+                     * Energy change of a single changed group in one pass over the static
+                     * particles, using the trial state (this) and the old state for positions
+                     * of the moved particles. Other changes fall back to calling `energy()`
+                     * on both states.
+                     */
+                    double delta(Energybase *basePtr, Change &change) override {
+                        auto old = dynamic_cast<decltype(this)>(basePtr);
+                        if (!fused || !old || change.empty() || change.dV || change.all
+                                || change.dNpart || change.groups.size()!=1
+                                || (Rc2_g2g<pc::infty && !change.groups[0].charge))
+                            return Energybase::delta(basePtr, change);
+
+                        prepare(change);
+                        double du=0;
+                        auto &d = change.groups[0];
+                        auto &g = spc.groups.at(d.index);
+                        int offset = g.begin()-spc.p.begin();
+
+                        if (d.charge) { // positions are unchanged so only charge dependent terms differ
+                            bool tabulated = useSites(d);
+                            if (!tabulated) {
+                                changedatoms.clear();
+                                if (d.all || d.atoms.empty())
+                                    for (int i=0; i<(int)g.size(); i++)
+                                        changedatoms.push_back(offset+i);
+                                else
+                                    for (int i : d.atoms)
+                                        changedatoms.push_back(offset+i);
+                            }
+                            changedmask.resize(spc.p.size(), 0);
+                            for (int i : changedatoms)
+                                changedmask[i] = 1;
+                            auto charged = [&](int i, const Tgroup &g2) { // particle i with group g2
+                                auto &&a = spc.p[i];
+                                auto &&aold = old->spc.p[i];
+                                int first = g2.begin()-spc.p.begin();
+                                for (int j=first; j<first+(int)g2.size(); j++) {
+                                    if (j==i || (changedmask[j] && j<i)) // count changed pairs once
+                                        continue;
+                                    auto &&b = spc.p[j];
+                                    Point r = spc.geo.vdist(a.pos, b.pos);
+                                    du += electrostatic(a, b, r) - electrostatic(aold, old->spc.p[j], r);
+                                }
+                            };
+                            for (int i : changedatoms) {
+                                if (tabulated) { // sites through the table, other groups as below
+                                    auto &&a = spc.p[i];
+                                    auto &&aold = old->spc.p[i];
+                                    size_t si = sites.site[i];
+                                    for (int j : sites.index)
+                                        if (j!=i && !(changedmask[j] && j<i))
+                                            du += (a.charge*spc.p[j].charge - aold.charge*old->spc.p[j].charge)
+                                                * sites.w[ sites.pair(si, sites.site[j]) ];
+                                    for (int k : sites.other)
+                                        if (!cut(spc.groups[k], g))
+                                            charged(i, spc.groups[k]);
+                                } else
+                                    for (auto &g2 : spc.groups)
+                                        if (!cut(g2, g))
+                                            charged(i, g2);
+                            }
+                            for (int i : changedatoms)
+                                changedmask[i] = 0;
+                            return du;
+                        }
+                        auto moved = [&](int i) { // particle i with all other groups
+                            auto &&a = spc.p[offset+i];
+                            auto &&aold = old->spc.p[offset+i];
+                            for (int j=0; j<(int)spc.groups.size(); j++)
+                                if (j!=d.index) {
+                                    int first = spc.groups[j].begin()-spc.p.begin();
+                                    du += i2range(a, aold, first, first+spc.groups[j].size(), Tkernel());
+                                }
+                        };
+
+                        if (d.atoms.size()==1) { // exactly one atom has moved; see `i2all()`
+                            int self = offset+d.atoms[0];
+                            moved(d.atoms[0]);
+                            du += i2range(spc.p[self], old->spc.p[self], offset, self, Tkernel())
+                                + i2range(spc.p[self], old->spc.p[self], self+1, offset+g.size(), Tkernel());
+                            return du;
+                        }
+                        if (d.atoms.empty()) // all atoms in group have moved
+                            for (int i=0; i<(int)g.size(); i++)
+                                moved(i);
+                        else
+                            for (int i : d.atoms)
+                                moved(i);
+                        if (d.internal)
+                            du += g_internal(g, d.atoms) - old->g_internal(old->spc.groups.at(d.index), d.atoms);
+                        return du;
+                    } //!< Energy change in a single pass over the static particles
+
             }; //!< Nonbonded, pair-wise additive energy term
 
+#ifdef DOCTEST_LIBRARY_INCLUDED
+        TEST_CASE("[Faunus] Nonbonded - mass center grid")
+        {
+            using doctest::Approx;
+            typedef Particle<Charge> T;
+            typedef Space<Geometry::Cuboid, T> Tspace;
+            typedef Potential::FunctorPotential<T> Tpairpot;
+
+            atoms<T> = R"([ {"A": {"q": 1.0}}, {"B": {"q": -1.0}} ])"_json.get<decltype(atoms<T>)>();
+            json j = R"({"default": [ {"coulomb": {"epsr": 80, "type": "plain", "cutoff": 100}} ], "cutoff_g2g": 3})"_json;
+
+            Tspace spc;
+            spc.geo = R"( {"length": [20,15,10]} )"_json;
+            spc.p.resize(300);
+            for (auto &i : spc.p) {
+                i.id = (&i-&spc.p[0]) % 2;
+                i.charge = i.id ? -1 : 1;
+                spc.geo.randompos(i.pos, Faunus::random);
+            }
+            for (auto i=spc.p.begin(); i!=spc.p.end(); ++i) { // molecules with one particle each
+                spc.groups.push_back( typename Tspace::Tgroup(i, i+1) );
+                spc.groups.back().cm = i->pos;
+            }
+
+            Nonbonded<Tspace,Tpairpot> pot(j, spc);
+            CHECK( spc.cmgridcutoff == Approx(3) );
+
+            auto brute = [&](int k) { // energy of group k, or of all if negative
+                double u=0;
+                for (size_t i=0; i<spc.groups.size(); i++)
+                    for (size_t l=i+1; l<spc.groups.size(); l++)
+                        if ((int)i==k || (int)l==k || k<0)
+                            if (spc.geo.sqdist(spc.groups[i].cm, spc.groups[l].cm)<9)
+                                u += pot.pairpot(spc.p[i], spc.p[l], spc.geo.vdist(spc.p[i].pos, spc.p[l].pos));
+                return u;
+            };
+
+            Change c;
+            c.all = true;
+            CHECK( pot.energy(c) == Approx(brute(-1)) );
+            c.clear();
+            c.dV = true;
+            CHECK( pot.energy(c) == Approx(brute(-1)) );
+
+            Change::data d;
+            d.index = 7;
+            d.all = true;
+            c.clear();
+            c.groups.push_back(d);
+            spc.geo.randompos(spc.p[7].pos, Faunus::random);
+            spc.groups[7].cm = spc.p[7].pos;
+            CHECK( pot.energy(c) == Approx(brute(7)) );
+        }
+
+        TEST_CASE("[Faunus] Nonbonded - tiles")
+        {
+            using doctest::Approx;
+            typedef Particle<Charge> T;
+            typedef Space<Geometry::Cuboid, T> Tspace;
+            typedef Potential::FunctorPotential<T> Tpairpot;
+
+            atoms<T> = R"([ {"A": {"q": 1.0}}, {"B": {"q": -1.0}} ])"_json.get<decltype(atoms<T>)>();
+            json j = R"({"default": [ {"coulomb": {"epsr": 80, "type": "plain", "cutoff": 100}} ]})"_json;
+
+            Tspace spc;
+            spc.geo = R"( {"length": [20,15,10]} )"_json;
+            spc.p.resize(600);
+            for (auto &i : spc.p) {
+                i.id = (&i-&spc.p[0]) < 400 ? 0 : 1;
+                i.charge = i.id ? -1 : 1;
+                spc.geo.randompos(i.pos, Faunus::random);
+            }
+            spc.groups.push_back( typename Tspace::Tgroup(spc.p.begin(), spc.p.begin()+400) ); // large atomic groups
+            spc.groups.push_back( typename Tspace::Tgroup(spc.p.begin()+400, spc.p.end()) );  // split into tiles
+            for (auto &g : spc.groups)
+                g.atomic = true;
+
+            Nonbonded<Tspace,Tpairpot> pot(j, spc);
+            double u=0;
+            for (size_t i=0; i<spc.p.size(); i++)
+                for (size_t k=i+1; k<spc.p.size(); k++)
+                    u += pot.pairpot(spc.p[i], spc.p[k], spc.geo.vdist(spc.p[i].pos, spc.p[k].pos));
+
+            Change c;
+            c.all = true;
+            CHECK( pot.energy(c) == Approx(u) );
+            c.clear();
+            c.dV = true;
+            CHECK( pot.energy(c) == Approx(u) );
+        }
+
+        TEST_CASE("[Faunus] Nonbonded - pair kernel")
+        {
+            using doctest::Approx;
+            typedef Particle<Charge> T;
+            typedef Space<Geometry::Cuboid, T> Tspace;
+            typedef Potential::CombinedPairPotential<Potential::CoulombGalore,Potential::WeeksChandlerAndersen<T>> Tpairpot;
+            CHECK( Potential::hasKernel<Tpairpot>::value );
+            CHECK( !Potential::hasKernel<Potential::FunctorPotential<T>>::value );
+            CHECK( Potential::hasKernel<Potential::SwitchPotential<T>>::value );
+            CHECK( !Potential::hasKernel<Potential::SplinedPotential<T>>::value );
+
+            atoms<T> = R"([ {"A": {"q": 1.0, "sigma": 1.0, "eps": 0.1}},
+                            {"B": {"q": -1.0, "sigma": 1.0, "eps": 0.1}} ])"_json.get<decltype(atoms<T>)>();
+            json j = R"({"type": "plain", "epsr": 80, "cutoff": 8})"_json;
+
+            Tspace spc;
+            spc.geo = R"( {"length": [20,15,10]} )"_json;
+            spc.p.resize(200);
+            for (auto &i : spc.p) {
+                i.id = (&i-&spc.p[0]) % 2;
+                i.charge = i.id ? -1 : 1;
+                spc.geo.randompos(i.pos, Faunus::random);
+            }
+            for (auto i=spc.p.begin(); i!=spc.p.end(); i+=2) { // molecules with two particles each
+                spc.groups.push_back( typename Tspace::Tgroup(i, i+2) );
+                spc.groups.back().cm = i->pos;
+            }
+
+            Nonbonded<Tspace,Tpairpot> pot(j, spc);
+            CHECK( spc.soa.enabled );
+
+            double u=0; // reference using the particle based pair potential
+            for (size_t i=0; i<spc.p.size(); i++)
+                for (size_t k=i+1; k<spc.p.size(); k++)
+                    if (i/2 != k/2)
+                        u += pot.pairpot(spc.p[i], spc.p[k], spc.geo.vdist(spc.p[i].pos, spc.p[k].pos));
+
+            Change c;
+            c.dV = true; // all group-to-group interactions
+            CHECK( pot.energy(c) == Approx(u) );
+
+            SUBCASE("runtime selected potentials") {
+                Potential::SwitchPotential<T> sw;
+                sw.from_json( R"({"default": [
+                    {"coulomb": {"type": "plain", "epsr": 80, "cutoff": 8}}, {"wca": {"mixing": "LB"}},
+                    {"repulsionr3": {"prefactor": 2}}, {"cos2": {"eps": 1, "rc": 2, "wc": 1}} ]})"_json );
+                for (size_t k=1; k<spc.p.size(); k++) {
+                    auto &a = spc.p[0], &b = spc.p[k];
+                    Point r = spc.geo.vdist(a.pos, b.pos);
+                    CHECK( sw(a.id, b.id, a.charge, b.charge, r.squaredNorm()) == Approx( sw(a, b, r) ) );
+                }
+            }
+
+            SUBCASE("delta") {
+                Tspace old; // old state with its own groups
+                old.geo = spc.geo;
+                old.p = spc.p;
+                for (auto i=old.p.begin(); i!=old.p.end(); i+=2)
+                    old.groups.push_back( typename Tspace::Tgroup(i, i+2) );
+                Nonbonded<Tspace,Tpairpot> potold(j, old);
+                pot.key = Energybase::NEW;
+                potold.key = Energybase::OLD;
+
+                spc.p[10].pos += Point(0.5,-0.3,0.2); // single atom move
+                spc.p[10].charge = 0.5;
+                c.clear();
+                Change::data d;
+                d.index = 5;
+                d.atoms = {0};
+                c.groups.push_back(d);
+                CHECK( pot.delta(&potold, c) == Approx( pot.energy(c)-potold.energy(c) ) );
+
+                spc.p[11].pos += Point(-0.4,0.1,0.3); // both atoms, incl. internal energy
+                c.groups[0].atoms = {0,1};
+                c.groups[0].internal = true;
+                CHECK( pot.delta(&potold, c) == Approx( pot.energy(c)-potold.energy(c) ) );
+
+                spc.p = old.p; // only charges change
+                spc.updateArrays();
+                spc.p[20].charge = 0.3;
+                spc.p[21].charge = -0.2;
+                c.groups[0].index = 10;
+                c.groups[0].charge = true;
+                CHECK( pot.delta(&potold, c) == Approx( pot.energy(c)-potold.energy(c) ) );
+
+                auto molecules_ = molecules<typename Tspace::Tpvec>; // tabulated couplings between fixed molecules
+                molecules<typename Tspace::Tpvec>.resize(1);
+                for (auto &g : spc.groups)
+                    g.id = 0;
+                for (auto &g : old.groups)
+                    g.id = 0;
+                double unew = pot.energy(c), uold = potold.energy(c); // without table
+                molecules<typename Tspace::Tpvec>[0].fixed = true;
+                pot.init();
+                potold.init();
+                CHECK( pot.energy(c) == Approx(unew) );
+                CHECK( potold.energy(c) == Approx(uold) );
+                CHECK( json(pot).at("nonbonded").at("fixed sites") == 200 );
+                CHECK( pot.delta(&potold, c) == Approx( pot.energy(c)-potold.energy(c) ) );
+                spc.p[21].charge = 0.7;
+                CHECK( pot.delta(&potold, c) == Approx( pot.energy(c)-potold.energy(c) ) );
+
+                molecules<typename Tspace::Tpvec>[0].fixed = false; // immobile in this simulation only
+                spc.immobile = {true};
+                pot.init();
+                unew = pot.energy(c);
+                spc.immobile.clear();
+                pot.init();
+                CHECK( pot.energy(c) == Approx(unew) );
+
+                json jc = j; // tabulated pairs respect the group cutoff
+                jc["cutoff_g2g"] = 6;
+                Nonbonded<Tspace,Tpairpot> potc(jc, spc);
+                unew = potc.energy(c);
+                spc.immobile = {true};
+                potc.init();
+                CHECK( potc.energy(c) == Approx(unew) );
+                molecules<typename Tspace::Tpvec> = molecules_;
+            }
+
+            SUBCASE("overlap") {
+                typedef Potential::CombinedPairPotential<Potential::CoulombGalore,Potential::HardSphere<T>> TpairpotHS;
+                Nonbonded<Tspace,TpairpotHS> hs(j, spc);
+                spc.p[0].pos = spc.p[3].pos + Point(0.5,0,0); // hard sphere overlap with another molecule
+                spc.groups[0].cm = spc.p[0].pos;
+                c.clear();
+                Change::data d;
+                d.index = 0;
+                d.atoms = {0};
+                c.groups.push_back(d);
+                CHECK( hs.energy(c) == pc::infty );
+                hs.earlyexit = true; // stop at first infinite pair energy
+                CHECK( hs.energy(c) == pc::infty );
+                c.groups[0].atoms = {0,1};
+                CHECK( hs.energy(c) == pc::infty );
+            }
+        }
+#endif
+
         template<typename Tspace, typename Tpairpot>
             class NonbondedCached : public Nonbonded<Tspace,Tpairpot> {
                 private:
@@ -811,6 +2605,8 @@ namespace Faunus {
                 public:
                     NonbondedCached(const json &j, Tspace &spc) : base(j,spc), spc(spc) {
                         base::name += "EM";
+                        base::fused = false;
+                        base::journal = false;
                         init();
                     }
 
@@ -841,12 +2637,17 @@ namespace Faunus {
                         if (!change.empty()) {
 
                             if (change.all || change.dV) {
-#pragma omp parallel for reduction (+:u) schedule (dynamic)
-                                for ( auto i = base::spc.groups.begin(); i < base::spc.groups.end(); ++i ) {
-                                    for ( auto j=i; ++j != base::spc.groups.end(); )
-                                        u += g2g( *i, *j );
-                                }
-                                return u;
+                                auto &groups = base::spc.groups;
+                                auto &partial = base::partial;
+                                partial.resize( groups.size() );
+                                executor.parallel_for(groups.size(), [&](size_t first, size_t last) {
+                                        for (size_t i=first; i<last; i++) {
+                                            partial[i] = 0;
+                                            for (size_t j=i+1; j<groups.size(); j++)
+                                                partial[i] += g2g( groups[i], groups[j] );
+                                        }
+                                        } );
+                                return std::accumulate(partial.begin(), partial.end(), 0.0); // fixed summation order
                             }
 
                             // if exactly ONE molecule is changed
@@ -882,6 +2683,7 @@ namespace Faunus {
                     }
 
                     void sync(Energybase *basePtr, Change &change) override {
+                        base::sync(basePtr, change);
                         auto other = dynamic_cast<decltype(this)>(basePtr);
                         assert(other);
                         if (change.all || change.dV)
@@ -896,6 +2698,645 @@ namespace Faunus {
                     } //!< Copy energy matrix from other
             }; //!< Nonbonded with cached energies (Energy Matrix)
 
+        /**
+         * @brief Nonbonded with a sparse cache of molecule-molecule energies
+         *
+         * Each molecular group keeps a list of neighboring molecular groups and the
+         * pair energy with these. Only pairs within `cutoff_g2g` are stored and
+         * each pair is kept in the lists of both groups. The trial state (key NEW)
+         * calculates and stores energies of pairs with moved groups, while the
+         * current state (key OLD) looks them up. Upon `sync()` only the lists of
+         * changed groups and their neighbors are copied (complexity: order neighbors).
+         *
+         * Changes in particle number are calculated without the cache which is then
+         * rebuilt on next use. Interactions with atomic groups are never cached.
+         */
+        template<typename Tspace, typename Tpairpot>
+            class NonbondedSparseCache : public Nonbonded<Tspace,Tpairpot> {
+                private:
+                    typedef Nonbonded<Tspace,Tpairpot> base;
+                    typedef typename Tspace::Tgroup Tgroup;
+                    typedef std::vector<std::pair<int,double>> Trow; // neighbor group index and energy
+                    std::vector<Trow> rows; // neighbor list for each group
+                    bool stale=true;  // true if `rows` must be rebuilt
+                    bool bypass=false; // true if cache should be ignored
+                    bool mirror=false; // true if only rows of the lower index should be updated
+                    size_t rebuilds=0;
+                    using base::spc;
+
+                    int index(const Tgroup &g) const { return &g - &spc.groups.front(); }
+
+                    void erase(Trow &row, int j) {
+                        auto it = std::find_if(row.begin(), row.end(), [j](auto &n){ return n.first==j; });
+                        if (it!=row.end()) {
+                            *it = row.back();
+                            row.pop_back();
+                        }
+                    }
+
+                    void setRow(int i, const Trow &row) {
+                        for (auto &n : rows[i])
+                            erase(rows[n.first], i);
+                        rows[i] = row;
+                        for (auto &n : rows[i])
+                            rows[n.first].push_back( {i, n.second} );
+                    } //!< Replace neighbors of group i and update neighbor lists of affected groups
+
+                    double lookup(int i, int j) const {
+                        for (auto &n : rows[i])
+                            if (n.first==j)
+                                return n.second;
+                        return 0;
+                    } //!< Cached energy between groups i and j; zero if not neighbors
+
+                    void mirrorRows() {
+                        for (size_t i=0; i<rows.size(); i++)
+                            for (size_t k=0, n=rows[i].size(); k<n; k++) {
+                                auto j = rows[i][k];
+                                if (j.first>(int)i)
+                                    rows[j.first].push_back( {int(i), j.second} );
+                            }
+                    } //!< Add reverse entries to rows that contain only upper neighbors
+
+                    double g2g(const Tgroup &g1, const Tgroup &g2, const std::vector<int> &index=std::vector<int>(), const std::vector<int> &jndex=std::vector<int>()) override {
+                        if (bypass || g1.atomic || g2.atomic)
+                            return base::g2g(g1, g2, index, jndex);
+                        int i = this->index(g1), j = this->index(g2);
+                        if (base::key==Energybase::OLD) // current state: use cache
+                            return lookup(i,j);
+                        if (base::cut(g1,g2)) // trial state: calculate and store all with all
+                            return 0;
+                        double u=0;
+                        for (auto &a : g1)
+                            u += base::i2g(a, g2);
+                        if (mirror)
+                            rows[std::min(i,j)].push_back( {std::max(i,j), u} );
+                        else {
+                            rows[i].push_back( {j,u} );
+                            rows[j].push_back( {i,u} );
+                        }
+                        return u;
+                    } //!< Full group-to-group energy; subsets are ignored as only differences matter
+
+                    void rebuild() {
+                        rebuilds++;
+                        rows.assign(spc.groups.size(), Trow());
+                        int N = spc.groups.size();
+                        Change c;
+                        c.all = true;
+                        base::prepare(c);
+                        executor.parallel_for(N, [&](size_t first, size_t last) {
+                                for (int i=first; i<int(last); i++)
+                                    if (!spc.groups[i].atomic)
+                                        spc.forEachGroupNear(i, [&](int j) {
+                                                auto &g = spc.groups[j];
+                                                if (j>i && !g.atomic && !base::cut(spc.groups[i], g)) {
+                                                    double u=0;
+                                                    for (auto &a : spc.groups[i])
+                                                        u += base::i2g(a, g);
+                                                    rows[i].push_back( {j,u} );
+                                                }
+                                                });
+                                } );
+                        mirrorRows();
+                        stale = false;
+                    } //!< Calculate all pair energies
+
+                    void to_json(json &j) const override {
+                        base::to_json(j);
+                        size_t n=0;
+                        for (auto &row : rows)
+                            n += row.size();
+                        j["cache"] = {
+                            {"pairs", n/2}, {"rebuilds", rebuilds},
+                            {"memory (kB)", n*sizeof(typename Trow::value_type)/1024.0}
+                        };
+                        _roundjson(j["cache"], 4);
+                    }
+
+                public:
+                    NonbondedSparseCache(const json &j, Tspace &spc) : base(j,spc) {
+                        base::fused = false;
+                        base::journal = false;
+                        init();
+                    }
+
+                    void init() override {
+                        base::init();
+                        rebuild();
+                    }
+
+                    double energy(Change &change) override {
+                        double u=0;
+                        if (!change.empty()) {
+                            if (stale || rows.size()!=spc.groups.size())
+                                rebuild();
+
+                            if (change.dNpart) { // calculate without cache; rebuild on next use
+                                bypass = true;
+                                u = base::energy(change);
+                                bypass = false;
+                                if (base::key!=Energybase::OLD)
+                                    stale = true;
+                                return u;
+                            }
+
+                            bool trial = (base::key!=Energybase::OLD);
+
+                            if (change.dV || change.all) {
+                                if (trial) {
+                                    rows.assign(spc.groups.size(), Trow());
+                                    mirror = true; // groups are visited in parallel
+                                }
+                                u = base::energy(change);
+                                if (trial)
+                                    mirrorRows();
+                                mirror = false;
+                                return u;
+                            }
+
+                            auto &moved = base::moved; // index of moved groups
+                            moved.clear();
+                            for (auto &d : change.groups) {
+                                if (spc.groups[d.index].atomic) { // atomic groups are never cached
+                                    bypass = true;
+                                    u = base::energy(change);
+                                    bypass = false;
+                                    return u;
+                                }
+                                moved.push_back(d.index);
+                            }
+                            std::sort( moved.begin(), moved.end() );
+
+                            base::prepare(change);
+                            if (trial)
+                                for (int i : moved)
+                                    setRow(i, Trow());
+
+                            auto ismoved = [&moved](int j) { return std::binary_search(moved.begin(), moved.end(), j); };
+                            for (auto i = moved.begin(); i != moved.end(); ++i) {
+                                auto &g = spc.groups[*i];
+                                for (auto j=i; ++j != moved.end(); ) // moved<->moved
+                                    u += g2g( g, spc.groups[*j] );
+                                if (trial)
+                                    spc.forEachGroupNear(*i, [&](int j) { // moved<->static
+                                            if (!ismoved(j))
+                                                u += g2g(g, spc.groups[j]);
+                                            });
+                                else {
+                                    for (auto &n : rows[*i]) // moved<->static molecules, from cache
+                                        if (!ismoved(n.first))
+                                            u += n.second;
+                                    spc.forEachGroupNear(*i, [&](int j) { // moved<->atomic groups
+                                            if (spc.groups[j].atomic)
+                                                u += base::g2g(g, spc.groups[j]);
+                                            });
+                                }
+                            }
+                            for (auto &d : change.groups)
+                                if (d.internal)
+                                    u += base::g_internal(spc.groups[d.index], d.atoms);
+                        }
+                        return u;
+                    }
+
+                    void sync(Energybase *basePtr, Change &change) override {
+                        base::sync(basePtr, change);
+                        auto other = dynamic_cast<decltype(this)>(basePtr);
+                        assert(other);
+                        if (other->stale)
+                            stale = true;
+                        else if (stale || change.all || change.dV || change.dNpart) {
+                            rows = other->rows;
+                            stale = false;
+                        } else
+                            for (auto &d : change.groups)
+                                setRow(d.index, other->rows[d.index]);
+                    } //!< Copy neighbor lists of changed groups from other
+            };
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+        TEST_CASE("[Faunus] NonbondedSparseCache")
+        {
+            using doctest::Approx;
+            typedef Particle<Charge> T;
+            typedef Space<Geometry::Cuboid, T> Tspace;
+            typedef Potential::FunctorPotential<T> Tpairpot;
+
+            atoms<T> = R"([ {"A": {"q": 1.0}}, {"B": {"q": -1.0}} ])"_json.get<decltype(atoms<T>)>();
+            json j = R"({"default": [ {"coulomb": {"epsr": 80, "type": "plain", "cutoff": 100}} ], "cutoff_g2g": 5})"_json;
+
+            Tspace spc1, spc2;
+            spc1.geo = R"( {"length": [20,15,10]} )"_json;
+            spc1.p.resize(200);
+            for (auto &i : spc1.p) {
+                i.id = (&i-&spc1.p[0]) % 2;
+                i.charge = i.id ? -1 : 1;
+                spc1.geo.randompos(i.pos, Faunus::random);
+            }
+            spc2.geo = spc1.geo;
+            spc2.p = spc1.p;
+            for (auto spc : {&spc1, &spc2})
+                for (auto i=spc->p.begin(); i!=spc->p.end(); i+=2) { // molecules with two particles each
+                    spc->groups.push_back( typename Tspace::Tgroup(i, i+2) );
+                    spc->groups.back().cm = i->pos;
+                }
+
+            NonbondedSparseCache<Tspace,Tpairpot> old(j, spc1), trial(j, spc2);
+            Nonbonded<Tspace,Tpairpot> ref1(j, spc1), ref2(j, spc2);
+            old.key = Energybase::OLD;
+            trial.key = Energybase::NEW;
+
+            Change all;
+            all.dV = true; // all group-to-group interactions
+            CHECK( old.energy(all) == Approx( ref1.energy(all) ) );
+            CHECK( trial.energy(all) == Approx( ref2.energy(all) ) );
+
+            for (int n=0; n<50; n++) {
+                Change c;
+                Change::data d;
+                d.index = int( Faunus::random() * spc2.groups.size() );
+                auto &g = spc2.groups[d.index];
+                Point dp = 2*ranunit(Faunus::random);
+                if (n%3==0) { // move a single particle...
+                    d.atoms = {1};
+                    (g.begin()+1)->pos += dp;
+                    spc2.geo.boundary((g.begin()+1)->pos);
+                } else { // ...or the whole molecule
+                    d.all = true;
+                    for (auto &i : g) {
+                        i.pos += dp;
+                        spc2.geo.boundary(i.pos);
+                    }
+                    g.cm = g.begin()->pos;
+                }
+                c.groups.push_back(d);
+                double du = trial.energy(c) - old.energy(c);
+                CHECK( du == Approx( ref2.energy(all) - ref1.energy(all) ) );
+                if (n%2==0) { // accept
+                    spc1.sync(spc2, c);
+                    old.sync(&trial, c);
+                } else { // reject
+                    spc2.sync(spc1, c);
+                    trial.sync(&old, c);
+                }
+            }
+            CHECK( old.energy(all) == Approx( ref1.energy(all) ) );
+        }
+#endif
+
+        /**
+         * @brief Nonbonded energy using a cell list and a spherical cutoff
+         *
+         * Each instance (and hence each `Space` state) keeps its own cell list
+         * which is updated incrementally from the `Change` object: the trial state
+         * when calculating the energy, and either state upon accept/reject when
+         * synching with the other state. Periodicity is detected from the geometry
+         * so that cuboids, slits and non-periodic containers are all handled.
+         *
+         * Pairs between groups and within atomic groups are found in the 26+1 neighboring
+         * cells and are included only if closer than `cutoff`, which must hence be at least
+         * the range of the pair potential. Pairs within molecular groups are
+         * evaluated without cutoff, exactly as in `Nonbonded`.
+         *
+         * If `skin` is larger than zero, per-particle Verlet lists with all pairs closer
+         * than `cutoff+skin` are built from the cell list and used instead of the cells.
+         * The lists are rebuilt only when a particle touched by a `Change` has moved
+         * more than half the skin since the last build.
+         */
+        template<typename Tspace, typename Tpairpot>
+            class NonbondedCellList : public Nonbonded<Tspace,Tpairpot> {
+                private:
+                    typedef Nonbonded<Tspace,Tpairpot> base;
+                    typedef typename Tspace::Tgroup Tgroup;
+                    typedef typename Tspace::Tparticle Tparticle;
+
+                    CellList<> cells;         // cells with index of all active particles
+                    std::vector<int> owner;   // group index of each particle
+                    std::vector<int> moved;   // index of changed particles (scratch)
+                    std::vector<char> ismoved;// true if particle has changed (scratch)
+                    double rc2;               // squared spherical cutoff
+                    double skin=0;            // Verlet list skin; zero if lists are disabled
+                    std::vector<int> vlist;   // Verlet lists of all particles, back to back
+                    std::vector<int> voffset; // start of each particle's Verlet list in `vlist`
+                    std::vector<Point> x0;    // positions at last Verlet list build
+                    unsigned long rebuilds=0, updates=0, vbuilds=0, vupdates=0; // `updates` and `vupdates` count MC moves
+
+                    void to_json(json &j) const override {
+                        base::to_json(j);
+                        j["celllist"] = {
+                            {"cutoff", std::sqrt(rc2)}, {"cells", cells.size()},
+                            {"rebuilds", rebuilds}, {"updates", updates} };
+                        if (skin>0)
+                            j["verlet"] = {
+                                {"skin", skin}, {"rebuilds", vbuilds},
+                                {"rebuild frequency", double(vupdates)/std::max(1ul, updates)},
+                                {"pairs", vlist.size()/2},
+                                {"memory (kB)", (vlist.capacity()+voffset.capacity())*sizeof(int)/1024.0
+                                    + x0.capacity()*sizeof(Point)/1024.0 } };
+                    }
+
+                    template<class Tfunc>
+                        inline void forEachNeighbor(int i, Tfunc f) const {
+                            if (skin>0)
+                                for (int k=voffset[i]; k<voffset[i+1]; k++)
+                                    f(vlist[k]);
+                            else
+                                cells.forEachNeighbor(cells.cellOf(i), f);
+                        } //!< Call `f(j)` for all candidate neighbors `j` to active particle `i`
+
+                    void buildVerlet() {
+                        auto &spc = base::spc;
+                        int N = spc.p.size();
+                        double rv2 = std::pow(std::sqrt(rc2)+skin, 2);
+                        vlist.clear();
+                        voffset.assign(N+1, 0);
+                        x0.resize(N);
+                        for (int i=0; i<N; i++) {
+                            int c = cells.cellOf(i);
+                            if (c>=0) {
+                                int a = owner[i];
+                                bool atomic = spc.groups[a].atomic;
+                                x0[i] = spc.p[i].pos;
+                                cells.forEachNeighbor(c, [&](int j) {
+                                        if (j!=i && (atomic || owner[j]!=a))
+                                            if (spc.geo.sqdist(spc.p[i].pos, spc.p[j].pos)<rv2)
+                                                vlist.push_back(j);
+                                        });
+                            }
+                            voffset[i+1] = vlist.size();
+                        }
+                        vbuilds++;
+                    } //!< Build Verlet lists from cell list (complexity: N)
+
+                    bool displaced(int i) const {
+                        return base::spc.geo.sqdist(base::spc.p[i].pos, x0[i]) > 0.25*skin*skin;
+                    } //!< true if particle `i` has moved more than half the skin since last Verlet build
+
+                    inline double i2i(const Tparticle &a, const Tparticle &b) const {
+                        Point r = base::spc.geo.vdist(a.pos, b.pos);
+                        if (r.squaredNorm()<rc2)
+                            return base::pairpot(a, b, r);
+                        return 0;
+                    } //!< Pair energy with spherical cutoff
+
+                    inline bool cut(int i, int j) const {
+                        auto &g1 = base::spc.groups[i];
+                        auto &g2 = base::spc.groups[j];
+                        if (g1.atomic || g2.atomic)
+                            return false;
+                        return base::spc.geo.sqdist(g1.cm, g2.cm) >= base::Rc2_g2g;
+                    } //!< true if group<->group interaction can be skipped (thread safe)
+
+                    void rebuild() {
+                        auto &spc = base::spc;
+                        cells.resize(spc.geo, std::sqrt(rc2)+skin);
+                        owner.assign(spc.p.size(), -1);
+                        ismoved.assign(spc.p.size(), false);
+                        for (size_t k=0; k<spc.groups.size(); k++) {
+                            auto &g = spc.groups[k];
+                            int first = g.begin()-spc.p.begin();
+                            std::fill(owner.begin()+first, owner.begin()+first+g.capacity(), k);
+                            for (size_t i=0; i<g.size(); i++)
+                                cells.insert(first+i, cells.index( cells.p2c( (g.begin()+i)->pos ) ));
+                        }
+                        if (skin>0)
+                            buildVerlet();
+                        rebuilds++;
+                    } //!< Rebuild cell list from scratch (complexity: N)
+
+                    /*
+                     * With `dNpart`, listed positions beyond the group size have been deactivated
+                     * and are erased, while active positions are moved or inserted. Since Verlet
+                     * lists hold active particles only, they are rebuilt after such a change.
+                     */
+                    void update(const Change &change) {
+                        if (change.all || change.dV || owner.size()!=base::spc.p.size()) {
+                            rebuild();
+                            return;
+                        }
+                        bool outdated = change.dNpart; // true if Verlet lists must be rebuilt
+                        auto move = [&](int i, bool active) {
+                            if (active) {
+                                cells.move(i, cells.index( cells.p2c( base::spc.p[i].pos ) ));
+                                if (skin>0 && !outdated)
+                                    outdated = displaced(i);
+                            } else
+                                cells.erase(i);
+                        };
+                        for (auto &d : change.groups) {
+                            auto &g = base::spc.groups.at(d.index);
+                            int first = g.begin()-base::spc.p.begin();
+                            int n = change.dNpart ? g.capacity() : g.size();
+                            if (d.all || d.atoms.empty())
+                                for (int i=0; i<n; i++)
+                                    move(first+i, i<(int)g.size());
+                            else
+                                for (int i : d.atoms)
+                                    move(first+i, i<(int)g.size());
+                        }
+                        if (outdated && skin>0)
+                            buildVerlet();
+                    } //!< Incremental update of cell list (complexity: number of changed particles)
+
+                    double sweep(bool internal) {
+                        auto &spc = base::spc;
+                        const int N = spc.p.size(), chunk = 64;
+                        auto &partial = base::partial;
+                        partial.resize( (N+chunk-1)/chunk );
+                        executor.parallel_for(partial.size(), [&](size_t first, size_t last) {
+                                for (size_t k=first; k<last; k++) {
+                                    double u=0;
+                                    for (int i=k*chunk; i<std::min(int(k+1)*chunk, N); i++)
+                                        if (cells.cellOf(i)>=0) {
+                                            int a = owner[i];
+                                            bool atomic = spc.groups[a].atomic;
+                                            forEachNeighbor(i, [&](int j) {
+                                                    if (j>i) {
+                                                        int b = owner[j];
+                                                        if (a==b ? atomic : !cut(a,b))
+                                                            u += i2i(spc.p[i], spc.p[j]);
+                                                    }
+                                                });
+                                        }
+                                    partial[k] = u;
+                                }
+                                } );
+                        double u = std::accumulate(partial.begin(), partial.end(), 0.0); // fixed summation order
+                        if (internal)
+                            for (auto &g : spc.groups)
+                                if (!g.atomic)
+                                    u += base::g_internal(g);
+                        return u;
+                    } //!< Energy of all active particles; `internal` adds intra-molecular energies
+
+                public:
+                    NonbondedCellList(const json &j, Tspace &spc) : base(j,spc) {
+                        base::name += "-celllist";
+                        base::fused = false;
+                        base::journal = false;
+                        rc2 = std::pow( j.at("cutoff").get<double>(), 2 );
+                        skin = j.value("skin", 0.0);
+                        if (skin<0)
+                            throw std::runtime_error("skin must be positive");
+                        if (skin>0)
+                            base::name = "nonbonded-verlet";
+                        rebuild();
+                    }
+
+                    void init() override {
+                        rebuild();
+                    }
+
+                    double energy(Change &change) override {
+                        auto &spc = base::spc;
+                        double u=0;
+
+                        if (!change.empty()) {
+                            if (base::key!=Energybase::OLD) // the old state is kept up-to-date by `sync()`
+                                update(change);
+
+                            if (change.dV || change.all)
+                                return sweep(change.all);
+
+                            moved.clear(); // active changed particles; with `dNpart` inactive ones are skipped
+                            for (auto &d : change.groups) {
+                                auto &g = spc.groups.at(d.index);
+                                int first = g.begin()-spc.p.begin();
+                                if (d.atoms.empty())
+                                    for (size_t i=0; i<g.size(); i++)
+                                        moved.push_back(first+i);
+                                else
+                                    for (int i : d.atoms)
+                                        if (i<(int)g.size())
+                                            moved.push_back(first+i);
+                            }
+                            for (int i : moved)
+                                ismoved[i] = true;
+
+                            for (auto &d : change.groups) {
+                                auto &g = spc.groups.at(d.index);
+                                int first = g.begin()-spc.p.begin();
+                                bool internal = d.internal || d.atoms.size()==1;
+                                auto interact = [&](int i) {
+                                    forEachNeighbor(i, [&](int j) {
+                                            if (j!=i)
+                                                if (!ismoved[j] || j>i) { // moved<->moved pairs only once
+                                                    if (owner[j]==d.index) {
+                                                        if (internal && g.atomic)
+                                                            u += i2i(spc.p[i], spc.p[j]);
+                                                    }
+                                                    else if (!cut(d.index, owner[j]))
+                                                        u += i2i(spc.p[i], spc.p[j]);
+                                                }
+                                            });
+                                };
+                                if (d.atoms.empty())
+                                    for (size_t i=0; i<g.size(); i++)
+                                        interact(first+i);
+                                else
+                                    for (int i : d.atoms)
+                                        if (i<(int)g.size())
+                                            interact(first+i);
+                                if (internal && !g.atomic)
+                                    u += base::g_internal(g, d.atoms);
+                            }
+
+                            for (int i : moved)
+                                ismoved[i] = false;
+                        }
+                        return u;
+                    }
+
+                    void sync(Energybase *basePtr, Change &change) override {
+                        base::sync(basePtr, change);
+                        auto other = dynamic_cast<decltype(this)>(basePtr);
+                        assert(other);
+                        auto n = vbuilds;
+                        update(change);
+                        updates++; // once per MC move
+                        if (vbuilds!=n)
+                            vupdates++;
+                    } //!< Update cell list with changes copied by `Space::sync()`
+            }; //!< Nonbonded with cell list and optional Verlet lists
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+        TEST_CASE("[Faunus] NonbondedCellList")
+        {
+            using doctest::Approx;
+            typedef Particle<Charge> T;
+            typedef Space<Geometry::Cuboid, T> Tspace;
+            typedef Potential::FunctorPotential<T> Tpairpot;
+
+            atoms<T> = R"([ {"A": {"q": 1.0}}, {"B": {"q": -1.0}} ])"_json.get<decltype(atoms<T>)>();
+            json j = R"({"default": [ {"coulomb": {"epsr": 80, "type": "plain", "cutoff": 4}} ], "cutoff": 4})"_json;
+
+            Tspace spc;
+            spc.geo = R"( {"length": [20,15,10]} )"_json;
+            spc.p.resize(200);
+            for (size_t i=0; i<spc.p.size(); i++) {
+                spc.p[i].id = i%2;
+                spc.p[i].charge = (i%2) ? -1 : 1;
+                spc.geo.randompos(spc.p[i].pos, Faunus::random);
+            }
+            spc.groups.push_back( typename Tspace::Tgroup(spc.p.begin(), spc.p.end()) );
+            spc.groups.back().atomic = true;
+
+            Nonbonded<Tspace,Tpairpot> brute(j, spc);
+            NonbondedCellList<Tspace,Tpairpot> cells(j, spc);
+            j["skin"] = 1.0;
+            NonbondedCellList<Tspace,Tpairpot> verlet(j, spc);
+
+            Change c;
+            c.all = true;
+            CHECK( cells.energy(c) == Approx(brute.energy(c)) );
+            CHECK( verlet.energy(c) == Approx(brute.energy(c)) );
+
+            Change::data d;
+            d.index = 0;
+            d.internal = true;
+            d.atoms = {5};
+            c.clear();
+            c.groups.push_back(d);
+            spc.geo.randompos(spc.p[5].pos, Faunus::random);
+            CHECK( cells.energy(c) == Approx(brute.energy(c)) );
+            CHECK( verlet.energy(c) == Approx(brute.energy(c)) );
+
+            c.groups[0].atoms = {7, 8, 100};
+            for (int i : c.groups[0].atoms)
+                spc.geo.randompos(spc.p[i].pos, Faunus::random);
+            CHECK( cells.energy(c) == Approx(brute.energy(c)) );
+            CHECK( verlet.energy(c) == Approx(brute.energy(c)) );
+
+            c.clear();
+            c.all = true;
+            CHECK( cells.energy(c) == Approx(brute.energy(c)) );
+            CHECK( verlet.energy(c) == Approx(brute.energy(c)) );
+
+            // deactivate and activate particles without rebuilding the cell list
+            auto &g = spc.groups.back();
+            c.clear();
+            c.dNpart = true;
+            d.dNpart = true;
+            d.atoms = {10, int(g.size())-1};
+            c.groups.push_back(d);
+            g.swapDeactivate( g.begin()+10 );
+            CHECK( cells.energy(c) == Approx(brute.energy(c)) );
+            CHECK( verlet.energy(c) == Approx(brute.energy(c)) );
+
+            c.groups[0].atoms = {int(g.size())};
+            g.swapActivate( g.end() );
+            spc.geo.randompos(spc.p[g.size()-1].pos, Faunus::random);
+            CHECK( cells.energy(c) == Approx(brute.energy(c)) );
+            CHECK( verlet.energy(c) == Approx(brute.energy(c)) );
+
+            c.clear();
+            c.all = true;
+            CHECK( cells.energy(c) == Approx(brute.energy(c)) );
+            CHECK( verlet.energy(c) == Approx(brute.energy(c)) );
+        }
+#endif
+
         /**
          * `udelta` is the total change of updating the energy function. If
          * not handled this will appear as an energy drift (which it is!). To
@@ -1240,7 +3681,7 @@ namespace Faunus {
         struct Example2D : public Energybase {
             Point& i; // reference to 1st particle in the system
             template<typename Tspace>
-                Example2D(const json &j, Tspace &spc): i(spc.p.at(0).pos) { name = "Example2D"; }
+                Example2D(const json &j, Tspace &spc): i(spc.p.at(0).pos) { name = "Example2D"; journal = true; }
             double energy(Change &change) override;
         };
 
@@ -1248,16 +3689,140 @@ namespace Faunus {
             class Hamiltonian : public Energybase, public BasePointerVector<Energybase> {
                 protected:
                     double maxenergy=pc::infty; //!< Maximum allowed energy change
+                    bool usefused=true; //!< Use fused evaluation if supported by all terms
                     typedef typename Tspace::Tparticle Tparticle;
+
+                    /*
+                     * With early rejection, terms are summed in the order given by `order`
+                     * and the summation stops once the partial sum plus the lower bounds,
+                     * `umin`, of the remaining terms exceeds `threshold`. The order is
+                     * periodically sorted by the expected cost of rejecting, i.e. time per
+                     * evaluation divided by the fraction of evaluations stopped by the term.
+                     */
+                    struct TermStatistics {
+                        double time=0, calls=0, stops=0;
+                    };
+                    std::vector<size_t> order; // evaluation order of terms
+                    std::vector<double> remaining; // sum of `umin` for terms after each position in `order`
+                    std::vector<TermStatistics> stats;
+                    unsigned long evaluations=0;
+                    int reorderinterval=1000; // number of evaluations between sorting terms
+
+                    void reorder() {
+                        if (order.size()!=vec.size()) {
+                            order.resize(vec.size());
+                            std::iota(order.begin(), order.end(), 0);
+                            stats.assign(vec.size(), TermStatistics());
+                        }
+                        else if (earlyrejection) {
+                            auto score = [&](size_t i) {
+                                auto &s = stats[i];
+                                double cost = s.time / std::max(s.calls, 1.0);
+                                return std::make_pair( s.stops>0 ? cost * s.calls / s.stops : pc::infty, cost );
+                            };
+                            std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                                    return score(a) < score(b); } );
+                        }
+                        remaining.resize(order.size());
+                        double lower=0;
+                        for (size_t n=order.size(); n-->0; ) {
+                            remaining[n] = lower;
+                            lower += vec[order[n]]->umin; // -inf is never added to +inf
+                        }
+                    } //!< Reset or sort the evaluation order of terms
+
+                    /*
+                     * With more than one thread, terms are evaluated as tasks on the global
+                     * executor. Full sweeps are always submitted while terms that took less
+                     * than `executor.threshold` on average for local changes run inline,
+                     * after the submitted tasks have been queued.
+                     */
+                    std::vector<double> partial; // result of each task
+                    std::vector<double> cost;    // average time of each task for local changes [s]
+                    std::vector<char> queued;    // true if a task is submitted rather than run inline
+
+                    template<class Tfunc>
+                        void tasks(size_t n, bool global, Tfunc f) {
+                            partial.resize(n);
+                            cost.resize(n, 0);
+                            queued.resize(n);
+                            auto run = [&](size_t first, size_t last) {
+                                for (size_t k=first; k<last; k++) {
+                                    auto t0 = std::chrono::steady_clock::now();
+                                    partial[k] = f(k);
+                                    if (!global)
+                                        cost[k] += 0.1 * (std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count() - cost[k]);
+                                }
+                            };
+                            Executor::TaskGroup group;
+                            for (size_t k=0; k<n; k++) {
+                                queued[k] = global || cost[k]>=executor.threshold;
+                                if (queued[k])
+                                    executor.submit(group, run, k, k+1);
+                            }
+                            try {
+                                for (size_t k=0; k<n; k++)
+                                    if (!queued[k])
+                                        run(k, k+1);
+                            } catch (...) {
+                                executor.wait(group);
+                                throw;
+                            }
+                            executor.wait(group);
+                        } //!< Store `f(k)` for `k` in `[0:n)` in `partial`; evaluated concurrently
+
                     void to_json(json &j) const override {
                         for (auto i : this->vec)
                             j.push_back(*i);
+                        if (earlyrejection) {
+                            json _j = json::array();
+                            for (auto i : order)
+                                _j.push_back( {
+                                        {"term", vec[i]->name},
+                                        {"stops", stats[i].stops},
+                                        {"time/call (ns)", std::round(1e9*stats[i].time/std::max(stats[i].calls, 1.0))} } );
+                            j.push_back( {{"earlyrejection", _j}} );
+                        }
+                        if (!usefused)
+                            j.push_back( {{"fused", false}} );
                     }
 
+                    template<typename Tpairpot, template<typename,typename> class Tnonbonded=Energy::Nonbonded>
+                        void addNonbonded(const json &j, Tspace &spc) {
+                            bool specialized = !std::is_same<Tnonbonded<Tspace,Tpairpot>, Energy::Nonbonded<Tspace,Tpairpot>>::value;
+                            if (specialized && (j.count("skin")==1 || j.count("cache")==1))
+                                throw std::runtime_error("`cache` and `skin` cannot be used with this nonbonded type");
+                            if (j.value("cache", false)) {
+                                if (j.count("skin")==1)
+                                    throw std::runtime_error("`cache` and `skin` cannot be combined");
+                                push_back<Energy::NonbondedSparseCache<Tspace,Tpairpot>>(j, spc);
+                            }
+                            else if (j.count("skin")==1)
+                                push_back<Energy::NonbondedCellList<Tspace,Tpairpot>>(j, spc);
+                            else
+                                push_back<Tnonbonded<Tspace,Tpairpot>>(j, spc);
+                        } //!< Adds nonbonded term; with a sparse energy cache if `cache` is true or Verlet lists if `skin` is given
+
                     void addEwald(const json &j, Tspace &spc) {
                         if (j.count("coulomb")==1)
-                            if (j["coulomb"].at("type")=="ewald")
-                                push_back<Energy::Ewald<Tspace>>(j["coulomb"], spc);
+                            if (j["coulomb"].at("type")=="ewald") {
+                                std::string policy = j["coulomb"].value("policy", "default");
+                                if (policy=="default")
+                                    push_back<Energy::Ewald<Tspace>>(j["coulomb"], spc);
+                                else if (policy=="eigen")
+                                    push_back<Energy::Ewald<Tspace,PolicyIonIon<Tspace,true>>>(j["coulomb"], spc);
+                                else if (policy=="recurrence")
+                                    push_back<Energy::Ewald<Tspace,PolicyIonIonRecurrence<Tspace>>>(j["coulomb"], spc);
+                                else if (policy=="iondip") {
+                                    if (j["coulomb"].value("groupcache", false))
+                                        throw std::runtime_error("groupcache cannot be used with dipoles");
+                                    EwaldIonDip<Tspace>::add(*this, j["coulomb"], spc);
+                                }
+                                else
+                                    throw std::runtime_error("unknown ewald policy '" + policy + "'");
+                            }
+                            else if (j["coulomb"].at("type")=="ewald_pme")
+                                push_back<Energy::EwaldPME<Tspace>>(j["coulomb"], spc);
                     } //!< Adds an instance of reciprocal space Ewald energies (if appropriate)
 
                 public:
@@ -1274,58 +3839,79 @@ namespace Faunus {
                             size_t oldsize = vec.size();
                             for (auto it=m.begin(); it!=m.end(); ++it) {
                                 try {
+                                    json val = it.value();
+                                    if (val.count("coulomb")==1)
+                                        if (val["coulomb"].count("autotune")==1) // choose Ewald parameters
+                                            val["coulomb"] = tuneEwald(val["coulomb"], spc, val.value("skin", -1.0));
+
                                     if (it.key()=="nonbonded_coulomblj")
-                                        push_back<Energy::Nonbonded<Tspace,CoulombLJ>>(it.value(), spc);
+                                        addNonbonded<CoulombLJ>(val, spc);
 
                                     if (it.key()=="nonbonded")
-                                        push_back<Energy::Nonbonded<Tspace,FunctorPotential<typename Tspace::Tparticle>>>(it.value(), spc);
+                                        addNonbonded<SwitchPotential<Tparticle>>(val, spc);
+
+                                    if (it.key()=="nonbonded_celllist")
+                                        push_back<Energy::NonbondedCellList<Tspace,SwitchPotential<Tparticle>>>(val, spc);
+
+                                    if (it.key()=="nonbonded_splined")
+                                        addNonbonded<SplinedPotential<Tparticle>>(val, spc);
 
                                     if (it.key()=="nonbonded_coulombhs")
-                                        push_back<Energy::Nonbonded<Tspace,CoulombHS>>(it.value(), spc);
+                                        addNonbonded<CoulombHS>(val, spc);
 
                                     if (it.key()=="nonbonded_coulombwca")
-                                        push_back<Energy::Nonbonded<Tspace,CoulombWCA>>(it.value(), spc);
+                                        addNonbonded<CoulombWCA>(val, spc);
 
                                     if (it.key()=="nonbonded_pmwca")
-                                        push_back<Energy::Nonbonded<Tspace,PrimitiveModelWCA>>(it.value(), spc);
+                                        addNonbonded<PrimitiveModelWCA>(val, spc);
 
                                     if (it.key()=="nonbonded_deserno")
-                                        push_back<Energy::NonbondedCached<Tspace,DesernoMembrane<typename Tspace::Tparticle>>>(it.value(), spc);
+                                        addNonbonded<DesernoMembrane<Tparticle>,Energy::NonbondedCached>(val, spc);
 
                                     if (it.key()=="nonbonded_desernoAA")
-                                        push_back<Energy::NonbondedCached<Tspace,DesernoMembraneAA<typename Tspace::Tparticle>>>(it.value(), spc);
+                                        addNonbonded<DesernoMembraneAA<Tparticle>,Energy::NonbondedCached>(val, spc);
 
                                     if (it.key()=="bonded")
-                                        push_back<Energy::Bonded<Tspace>>(it.value(), spc);
+                                        push_back<Energy::Bonded<Tspace>>(val, spc);
 
                                     if (it.key()=="confine")
-                                        push_back<Energy::Confine<Tspace>>(it.value(), spc);
+                                        push_back<Energy::Confine<Tspace>>(val, spc);
 
                                     if (it.key()=="example2d")
-                                        push_back<Energy::Example2D>(it.value(), spc);
+                                        push_back<Energy::Example2D>(val, spc);
 
                                     if (it.key()=="isobaric")
-                                        push_back<Energy::Isobaric<Tspace>>(it.value(), spc);
+                                        push_back<Energy::Isobaric<Tspace>>(val, spc);
 
                                     if (it.key()=="penalty")
 #ifdef ENABLE_MPI
-                                        push_back<Energy::PenaltyMPI<Tspace>>(it.value(), spc);
+                                        push_back<Energy::PenaltyMPI<Tspace>>(val, spc);
 #else
-                                        push_back<Energy::Penalty<Tspace>>(it.value(), spc);
+                                        push_back<Energy::Penalty<Tspace>>(val, spc);
 #endif
 #ifdef ENABLE_POWERSASA
                                     if (it.key()=="sasa")
-                                        push_back<Energy::SASAEnergy<Tspace>>(it.value(), spc);
+                                        push_back<Energy::SASAEnergy<Tspace>>(val, spc);
 #endif
                                     // additional energies go here...
 
-                                    addEwald(it.value(), spc); // add reciprocal Ewald terms if appropriate
+                                    addEwald(val, spc); // add reciprocal Ewald terms if appropriate
 
                                     if (it.key()=="maxenergy") {
                                         maxenergy = it.value().get<double>();
                                         continue;
                                     }
 
+                                    if (it.key()=="earlyrejection") {
+                                        earlyrejection = it.value().get<bool>();
+                                        continue;
+                                    }
+
+                                    if (it.key()=="fused") {
+                                        usefused = it.value().get<bool>();
+                                        continue;
+                                    }
+
                                     if (vec.size()==oldsize)
                                         throw std::runtime_error("unknown term");
 
@@ -1334,30 +3920,113 @@ namespace Faunus {
                                 }
                             }
                         }
+                        fused = usefused && std::all_of(vec.begin(), vec.end(), [](auto &i){ return i->fused; });
+                        journal = std::all_of(vec.begin(), vec.end(), [](auto &i){ return i->journal; });
                     }
 
+                    double threshold=pc::infty; //!< Energy above which summation can stop (early rejection)
+                    bool earlyrejection=false; //!< Let Monte Carlo moves stop energy evaluations once rejection is certain
+
                     double energy(Change &change) override {
                         double du=0;
-                        for (auto i : this->vec) {
+                        if (order.size()!=vec.size())
+                            reorder();
+                        const bool early = threshold<pc::infty;
+                        for (size_t n=0; n<order.size(); n++) {
+                            auto &i = this->vec[order[n]];
                             i->key=key;
-                            du += i->energy(change);
+                            i->earlyexit=early;
+                            if (early) {
+                                auto &s = stats[order[n]];
+                                auto t0 = std::chrono::steady_clock::now();
+                                du += i->energy(change);
+                                s.time += std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+                                s.calls++;
+                                if (du>threshold && (du==pc::infty || du+remaining[n]>threshold)) {
+                                    s.stops++;
+                                    break; // rejection is certain
+                                }
+                            } else
+                                du += i->energy(change);
                             if (du>maxenergy)
                                 break; // stop summing energies
                         }
+                        if (early && ++evaluations % reorderinterval == 0)
+                            reorder();
                         return du;
                     } //!< Energy due to changes
 
+                    void energy(Change &change, Hamiltonian &old, double &unew, double &uold) {
+                        if (old.size()!=size())
+                            throw std::runtime_error("hamiltonian mismatch");
+                        if (executor.size()==1) {
+                            unew = energy(change);
+                            uold = old.energy(change);
+                            return;
+                        }
+                        if (order.size()!=vec.size())
+                            reorder();
+                        const size_t n = size();
+                        for (size_t i=0; i<n; i++) {
+                            this->vec[i]->key = key;
+                            old.vec[i]->key = old.key;
+                            this->vec[i]->earlyexit = old.vec[i]->earlyexit = false;
+                        }
+                        tasks(2*n, change.all || change.dV, [&](size_t k) {
+                                return (k<n) ? this->vec[k]->energy(change) : old.vec[k-n]->energy(change); } );
+                        auto sum = [&](size_t offset) {
+                            double u=0;
+                            for (size_t i : order) {
+                                u += partial[offset+i];
+                                if (u>maxenergy)
+                                    break; // as in `energy()`
+                            }
+                            return u;
+                        };
+                        unew = sum(0);
+                        uold = sum(n);
+                    } //!< Energies due to changes of this (trial) state and of `old`; terms and states are evaluated concurrently
+
+                    double delta(Energybase *basePtr, Change &change) override {
+                        auto other = dynamic_cast<decltype(this)>(basePtr);
+                        if (other==nullptr || other->size()!=size())
+                            throw std::runtime_error("hamiltonian mismatch");
+                        for (size_t i=0; i<size(); i++) {
+                            this->vec[i]->key = key;
+                            other->vec[i]->key = other->key;
+                        }
+                        if (executor.size()==1) {
+                            double du=0;
+                            for (size_t i=0; i<size(); i++)
+                                du += this->vec[i]->delta( other->vec[i].get(), change );
+                            return du;
+                        }
+                        tasks(size(), change.all || change.dV, [&](size_t i) {
+                                return this->vec[i]->delta( other->vec[i].get(), change ); } );
+                        return std::accumulate(partial.begin(), partial.end(), 0.0); // fixed summation order
+                    } //!< Energy change with respect to the same Hamiltonian in the old state
+
                     void init() override {
                         for (auto i : this->vec)
                             i->init();
                     }
 
+                    void commit(Change &change, bool accept) override {
+                        for (auto i : this->vec)
+                            i->commit(change, accept);
+                    }
+
                     void sync(Energybase* basePtr, Change &change) override {
                         auto other = dynamic_cast<decltype(this)>(basePtr);
                         if (other)
                             if (other->size()==size()) {
                                 for (size_t i=0; i<size(); i++)
                                     this->vec[i]->sync( other->vec[i].get(), change );
+                                if (earlyrejection && other->key==NEW) { // statistics are collected in the trial state
+                                    order = other->order;
+                                    remaining = other->remaining;
+                                    stats = other->stats;
+                                }
                                 return;
                             }
                         throw std::runtime_error("hamiltonian mismatch");
@@ -0,0 +1,143 @@
+#include <chrono>
+#include <stdexcept>
+#include "executor.h"
+
+namespace Faunus {
+
+    Executor executor;
+
+    thread_local Executor* Executor::current = nullptr;
+    thread_local int Executor::self = 0;
+
+    void Executor::Queue::push(const Executor::Task &t) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tail-head == ring.size()) { // full; double capacity keeping the order
+            std::vector<Task> v(2*ring.size());
+            for (size_t i=head; i<tail; i++)
+                v[i-head] = ring[i & (ring.size()-1)];
+            tail -= head;
+            head = 0;
+            ring.swap(v);
+        }
+        ring[tail++ & (ring.size()-1)] = t;
+    }
+
+    bool Executor::Queue::pop(Executor::Task &t) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tail==head)
+            return false;
+        t = ring[--tail & (ring.size()-1)];
+        return true;
+    }
+
+    bool Executor::Queue::steal(Executor::Task &t) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tail==head)
+            return false;
+        t = ring[head++ & (ring.size()-1)];
+        return true;
+    }
+
+    bool Executor::take(Executor::Task &t) {
+        if (queued==0)
+            return false;
+        int n = queues.size();
+        int i = index();
+        if (queues[i]->pop(t)) { // newest own task first...
+            queued--;
+            return true;
+        }
+        for (int k=1; k<n; k++) // ...or the oldest of another thread
+            if (queues[(i+k) % n]->steal(t)) {
+                queued--;
+                return true;
+            }
+        return false;
+    }
+
+    void Executor::execute(Executor::Task &t) {
+        try {
+            t.run(t.callable, t.first, t.last);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(t.group->mutex);
+            if (!t.group->error)
+                t.group->error = std::current_exception();
+        }
+        t.group->pending--; // last access to the group; the waiting thread may now return
+    }
+
+    void Executor::worker(int i) {
+        using clock = std::chrono::steady_clock;
+        current = this;
+        self = i;
+        Task t;
+        auto idle = clock::now();
+        while (!stop) {
+            if (take(t)) {
+                execute(t);
+                idle = clock::now();
+            }
+            else if (std::chrono::duration<double>(clock::now()-idle).count() < spin)
+                std::this_thread::yield();
+            else {
+                sleeping++;
+                {
+                    std::unique_lock<std::mutex> lock(sleepmutex);
+                    wakeup.wait(lock, [&]{ return stop || queued>0; });
+                }
+                sleeping--;
+                idle = clock::now();
+            }
+        }
+    }
+
+    Executor::Executor(int nthreads) {
+        resize(nthreads);
+    }
+
+    Executor::~Executor() {
+        resize(1);
+    }
+
+    void Executor::resize(int nthreads) {
+        if (nthreads<1)
+            throw std::runtime_error("number of threads must be positive");
+        if (current==this)
+            throw std::runtime_error("executor cannot be resized from a task");
+        {
+            std::lock_guard<std::mutex> lock(sleepmutex);
+            stop = true;
+            wakeup.notify_all();
+        }
+        for (auto &t : threads)
+            t.join();
+        threads.clear();
+        stop = false;
+        queues.clear();
+        for (int i=0; i<nthreads; i++)
+            queues.emplace_back(new Queue());
+        queued = 0;
+        for (int i=1; i<nthreads; i++)
+            threads.emplace_back(&Executor::worker, this, i);
+    }
+
+    int Executor::size() const {
+        return threads.size()+1;
+    }
+
+    void Executor::wait(Executor::TaskGroup &group) {
+        Task t;
+        while (group.pending>0) {
+            if (take(t))
+                execute(t);
+            else
+                std::this_thread::yield();
+        }
+        if (group.error) {
+            auto e = group.error;
+            group.error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+}//namespace
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <vector>
+#include <limits>
+
+namespace Faunus {
+
+    /**
+     * @brief Task based executor with a pool of work-stealing threads
+     *
+     * Each thread, including the calling thread, owns a queue of tasks. Submitted
+     * tasks go to the queue of the submitting thread and idle threads steal from
+     * the front of other queues. A thread waiting for a `TaskGroup` executes pending
+     * tasks meanwhile so that tasks may themselves submit and wait for subtasks.
+     * A task is a callable, `f(first,last)`, and an index range; the callable is
+     * passed by reference and must stay alive until the group has been waited for.
+     * Tasks whose estimated cost is below `threshold` run inline without queueing.
+     *
+     * Example:
+     *
+     * ```{.cpp}
+     *     std::vector<double> u(n);
+     *     executor.parallel_for(n, [&](size_t first, size_t last) {
+     *         for (size_t i=first; i<last; i++)
+     *             u[i] = work(i);
+     *     });
+     * ```
+     */
+    class Executor {
+        public:
+            class TaskGroup {
+                friend class Executor;
+                std::atomic<int> pending{0};
+                std::exception_ptr error; // first exception thrown by a task
+                std::mutex mutex;
+            }; //!< Tasks that are waited for together
+
+        private:
+            struct Task {
+                void (*run)(void*, size_t, size_t)=nullptr;
+                void *callable=nullptr;
+                size_t first=0, last=0;
+                TaskGroup *group=nullptr;
+            };
+
+            struct Queue {
+                std::mutex mutex;
+                std::vector<Task> ring; // circular buffer; size is a power of two
+                size_t head=0, tail=0;  // owner pushes and pops at `tail`, thieves steal at `head`
+                Queue() : ring(256) {}
+                void push(const Task&);
+                bool pop(Task&);
+                bool steal(Task&);
+            };
+
+            std::vector<std::unique_ptr<Queue>> queues; // one per thread; index 0 for external threads
+            std::vector<std::thread> threads;
+            std::atomic<int> queued{0};   // tasks waiting in all queues
+            std::atomic<int> sleeping{0}; // idle workers blocked on `wakeup`
+            std::atomic<bool> stop{false};
+            std::mutex sleepmutex;
+            std::condition_variable wakeup;
+
+            static thread_local Executor *current; // executor owning the current thread, if any
+            static thread_local int self;          // queue index of the current thread in `current`
+
+            int index() const { return (current==this) ? self : 0; } // queue of the current thread
+
+            bool take(Task&);    // pop from own queue or steal from others
+            void execute(Task&);
+            void worker(int);
+
+        public:
+            double threshold=1e-5; //!< Tasks estimated to take less time than this [s] run inline
+            double spin=2e-4;      //!< Time an idle worker keeps looking for tasks before sleeping [s]
+
+            Executor(int nthreads=1);
+            ~Executor();
+            Executor(const Executor&)=delete;
+            Executor& operator=(const Executor&)=delete;
+
+            void resize(int nthreads); //!< Set total number of threads, including the calling thread
+            int size() const;          //!< Total number of threads, including the calling thread
+
+            template<class Tfunc>
+                void submit(TaskGroup &group, Tfunc &f, size_t first, size_t last, double cost=std::numeric_limits<double>::infinity()) {
+                    if (threads.empty() || cost<threshold) {
+                        f(first, last);
+                        return;
+                    }
+                    Task t;
+                    t.run = [](void *c, size_t i, size_t j) { (*static_cast<Tfunc*>(c))(i, j); };
+                    t.callable = &f;
+                    t.first = first;
+                    t.last = last;
+                    t.group = &group;
+                    group.pending++;
+                    queues[index()]->push(t);
+                    queued++;
+                    if (sleeping>0) {
+                        std::lock_guard<std::mutex> lock(sleepmutex);
+                        wakeup.notify_one();
+                    }
+                } //!< Run `f(first,last)` as a task; inline if single threaded or if `cost` [s] is below `threshold`
+
+            void wait(TaskGroup &group); //!< Execute tasks until all in `group` are done; rethrows task exceptions
+
+            template<class Tfunc>
+                void parallel_for(size_t n, Tfunc &&f, size_t chunk=1) {
+                    chunk = std::max(chunk, size_t(1));
+                    if (threads.empty() || n<=chunk) {
+                        if (n>0)
+                            f(size_t(0), n);
+                        return;
+                    }
+                    TaskGroup group;
+                    for (size_t first=chunk; first<n; first+=chunk)
+                        submit(group, f, first, std::min(first+chunk, n));
+                    try {
+                        f(size_t(0), chunk); // first chunk by the calling thread
+                    } catch (...) {
+                        wait(group);
+                        throw;
+                    }
+                    wait(group);
+                } //!< Call `f(first,last)` on chunks of `[0:n)` in parallel and wait for all
+    };
+
+    extern Executor executor; //!< Global executor used by energies and moves
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+    TEST_CASE("[Faunus] Executor")
+    {
+        Executor ex(4);
+        CHECK( ex.size() == 4 );
+
+        std::vector<double> v(1000);
+        ex.parallel_for(v.size(), [&](size_t first, size_t last) {
+                for (size_t i=first; i<last; i++)
+                    v[i] = i;
+                }, 7);
+        double sum=0;
+        for (double x : v)
+            sum += x;
+        CHECK( sum == 999*1000/2 );
+
+        // tasks that submit and wait for subtasks
+        std::atomic<int> cnt{0};
+        auto inner = [&](size_t first, size_t last) { cnt += last-first; };
+        auto outer = [&](size_t first, size_t last) {
+            for (size_t i=first; i<last; i++)
+                ex.parallel_for(100, inner, 3);
+        };
+        Executor::TaskGroup group;
+        for (size_t i=0; i<10; i++)
+            ex.submit(group, outer, i, i+1);
+        ex.wait(group);
+        CHECK( cnt == 1000 );
+
+        // inline below threshold and exceptions propagated to the waiting thread
+        auto id = std::this_thread::get_id();
+        bool same = false;
+        auto cheap = [&](size_t, size_t) { same = (std::this_thread::get_id()==id); };
+        ex.submit(group, cheap, 0, 1, 0.0);
+        CHECK( same );
+        auto bad = [](size_t, size_t) { throw std::runtime_error("task"); };
+        ex.submit(group, bad, 0, 1);
+        CHECK_THROWS( ex.wait(group) );
+
+        ex.resize(1);
+        CHECK( ex.size() == 1 );
+        cnt = 0;
+        ex.parallel_for(100, inner, 3);
+        CHECK( cnt == 100 );
+    }
+#endif
+
+}//namespace
@@ -354,8 +354,8 @@ namespace Faunus {
          *
          * [More info](http://dx.doi.org/10.1080/2151237X.2008.10129266)
          */
-        template<class Tspace, class GroupIndex>
-            Point trigoCom( const Tspace &spc, const GroupIndex &groups, const std::vector<int> &dir = {0, 1, 2} )
+        template<class Tspace, class GroupIndex, class Tdir=std::array<int,3>>
+            Point trigoCom( const Tspace &spc, const GroupIndex &groups, const Tdir &dir = {0, 1, 2} )
             {
                 assert(!dir.empty() && dir.size() <= 3);
                 Point xhi(0, 0, 0), zeta(0, 0, 0), theta(0, 0, 0), com(0, 0, 0);
@@ -51,15 +51,23 @@ namespace Faunus {
      * - Just deactivated elements are moved to `end()` and can be retrieved from there.
      * - Just activated elements are placed at `end()-n`.
      * - The true size is given by `capacity()`
+     *
+     * Where the order of elements is irrelevant, `swapDeactivate()` and
+     * `swapActivate()` move a single element across the boundary between
+     * active and inactive elements in constant time by swapping it with the
+     * last active, respectively first inactive, element.
+     *
+     * The iterator type defaults to that of `std::vector<T>` but any random access
+     * iterator may be used, _e.g._ that of a structure-of-arrays container.
      */
-    template<class T>
-        class ElasticRange : public IterRange<typename std::vector<T>::iterator> {
+    template<class T, class TIterator=typename std::vector<T>::iterator>
+        class ElasticRange : public IterRange<TIterator> {
             public:
-                typedef typename std::vector<T>::iterator Titer;
+                typedef TIterator Titer;
             private:
                 Titer _trueend;
             public:
-                typedef IterRange<typename std::vector<T>::iterator> base;
+                typedef IterRange<Titer> base;
                 using base::begin;
                 using base::end;
                 using base::size;
@@ -88,6 +96,16 @@ namespace Faunus {
                     assert(size() + inactive().size() == capacity());
                 } //!< Activate previously deactivated elements
 
+                void swapDeactivate(Titer it) {
+                    assert(it>=begin() && it<end());
+                    std::iter_swap( it, --end() );
+                } //!< Deactivate element by swapping with the last active element; order is not preserved (complexity: order 1)
+
+                void swapActivate(Titer it) {
+                    assert(it>=end() && it<_trueend);
+                    std::iter_swap( it, end()++ );
+                } //!< Activate element by swapping with the first inactive element; order is not preserved (complexity: order 1)
+
                 Titer& trueend() { return _trueend; }
                 const Titer& trueend() const { return _trueend; }
 
@@ -141,12 +159,26 @@ namespace Faunus {
         CHECK( *r.begin()!=-7 );
         r.relocate(v.begin(), v2.begin());
         CHECK( *r.begin()==-7 );
+
+        // swap with boundary between active and inactive elements
+        v = {10,20,30,40};
+        ElasticRange<int> s(v.begin(), v.end());
+        s.swapDeactivate( s.begin()+1 );
+        CHECK( s.size() == 3 );
+        CHECK( v == std::vector<int>({10,40,30,20}) );
+        s.swapDeactivate( s.end()-1 );
+        CHECK( v == std::vector<int>({10,40,30,20}) );
+        CHECK( s.size() == 2 );
+        s.swapActivate( s.end()+1 );
+        CHECK( v == std::vector<int>({10,40,20,30}) );
+        CHECK( s.size() == 3 );
+        CHECK( *(s.end()-1) == 20 );
     }
 #endif
 
-    template<class T /** Particle type */>
-        struct Group : public ElasticRange<T> {
-            typedef ElasticRange<T> base;
+    template<class T /** Particle type */, class TIterator=typename std::vector<T>::iterator>
+        struct Group : public ElasticRange<T,TIterator> {
+            typedef ElasticRange<T,TIterator> base;
             typedef typename base::Titer iter;
             using base::begin;
             using base::end;
@@ -211,25 +243,25 @@ namespace Faunus {
                 } //!< Group subset matching given `index` (Complexity: linear with index size)
 
             auto positions() const {
-                return ranges::view::transform(*this, [](auto &i) -> Point& {return i.pos;});
+                return ranges::view::transform(*this, [](auto &&i) -> Point& {return i.pos;});
             } //!< Iterable range with positions
 
             template<typename TdistanceFunc>
                 void unwrap(const TdistanceFunc &vdist) {
-                    for (auto &i : *this)
+                    for (auto &&i : *this)
                         i.pos = cm + vdist( i.pos, cm );
                 } //!< Remove periodic boundaries with respect to mass center (Order N complexity).
 
             void wrap(Geometry::BoundaryFunction boundary) {
                 boundary(cm);
-                for (auto &i : *this)
+                for (auto &&i : *this)
                     boundary(i.pos);
             } //!< Apply periodic boundaries (Order N complexity).
 
             void translate(const Point &d, Geometry::BoundaryFunction boundary=[](Point&){}) {
                 cm += d;
                 boundary(cm);
-                for (auto &i : *this) {
+                for (auto &&i : *this) {
                     i.pos += d;
                     boundary(i.pos);
                 }
@@ -241,16 +273,16 @@ namespace Faunus {
 
         }; //!< Groups of particles
 
-    template<class T /** Particle type */>
-        void to_json(json &j, const Group<T> &g) {
+    template<class T /** Particle type */, class TIterator>
+        void to_json(json &j, const Group<T,TIterator> &g) {
             j = {
                 {"id", g.id}, {"cm", g.cm}, {"atomic", g.atomic}, {"size", g.size()},
                 {"capacity", g.capacity()}
             };
         }
 
-    template<class T /** Particle type */>
-        void from_json(const json &j, Group<T> &g) {
+    template<class T /** Particle type */, class TIterator>
+        void from_json(const json &j, Group<T,TIterator> &g) {
             g.trueend() = g.begin() + j.at("capacity");
             g.resize( j.at("size") );
             g.id = j.at("id").get<unsigned int>();
@@ -260,7 +292,7 @@ namespace Faunus {
 
     template<class Trange>
         auto positions(Trange &r) {
-            return ranges::view::transform(r, [](auto &i) -> Point& {return i.pos;});
+            return ranges::view::transform(r, [](auto &&i) -> Point& {return i.pos;});
         } //!< Iterable range with positions (works for groups and particle vectors)
 
 #ifdef DOCTEST_LIBRARY_INCLUDED
@@ -37,11 +37,17 @@ namespace Faunus {
             RandomInserter() : name("random") {}
 
             Tpvec operator()( Geometry::GeometryBase &geo, const Tpvec &p, TMoleculeData &mol )
+            {
+                Tpvec v;
+                operator()(geo, p, mol, v);
+                return v;
+            }
+
+            void operator()( Geometry::GeometryBase &geo, const Tpvec &p, TMoleculeData &mol, Tpvec &v )
             {
                 if (std::fabs(geo.getVolume())<1e-20)
                     throw std::runtime_error("geometry has zero volume");
                 bool _overlap = true;
-                Tpvec v;
                 int cnt = 0;
                 int _ntry = 1000000;
                 QuaternionRotate rot;
@@ -107,8 +113,7 @@ namespace Faunus {
                             }
                 }
                 while ( _overlap == true );
-                return v;
-            }
+            } //!< As above but stores the result in `v` to reuse its memory
         };
 
     /**
@@ -136,6 +141,7 @@ namespace Faunus {
                 bool atomic=false;         //!< True if atomic group (salt etc.)
                 bool rotate=true;          //!< True if molecule should be rotated upon insertion
                 bool keeppos=false;        //!< Keep original positions of `structure`
+                bool fixed=false;          //!< True if positions are never changed, allowing precomputed interactions
                 double activity=0;         //!< Chemical activity (mol/l)
                 Point insdir = {1,1,1};    //!< Insertion directions
                 Point insoffset = {0,0,0}; //!< Insertion offset
@@ -177,7 +183,7 @@ namespace Faunus {
                  * is set to unity. Specify a custom distribution using the
                  * `weight` keyword.
                  */
-                Tpvec getRandomConformation()
+                const Tpvec& getRandomConformation()
                 {
                     if ( conformations.empty())
                         throw std::runtime_error("No configurations for molecule '" + name +
@@ -256,6 +262,8 @@ namespace Faunus {
                 {"id", a.id()}, {"insdir", a.insdir}, {"insoffset", a.insoffset},
                 {"keeppos", a.keeppos}, {"structure", a.structure}, {"bondlist", a.bonds}
             };
+            if (a.fixed)
+                j[a.name]["fixed"] = true;
             j[a.name]["atoms"] = json::array();
             for (auto id : a.atoms)
                 j[a.name]["atoms"].push_back( atoms<Tparticle>.at(id).name );
@@ -274,6 +282,7 @@ namespace Faunus {
                     a.insoffset = val.value("insoffset", a.insoffset);
                     a.activity = val.value("activity", a.activity) * 1.0_molar;
                     a.keeppos = val.value("keeppos", a.keeppos);
+                    a.fixed = val.value("fixed", a.fixed);
                     a.atomic = val.value("atomic", a.atomic);
                     a.insdir = val.value("insdir", a.insdir);
                     a.bonds  = val.value("bondlist", a.bonds);
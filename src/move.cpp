@@ -57,6 +57,10 @@ namespace Faunus {
             return 0; // du
         }
 
+        bool Movebase::displaces(int) const {
+            return true; // unless known otherwise
+        }
+
         void Movebase::_accept(Change &) {}
 
         void Movebase::_reject(Change &) {}
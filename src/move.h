@@ -27,6 +27,8 @@ namespace Faunus {
                 std::string name;      //!< Name of move
                 std::string cite;      //!< Reference
                 int repeat=1;          //!< How many times the move should be repeated per sweep
+                bool energybias=false; //!< True if `bias()` depends on the energies
+                bool journal=false;    //!< True if modifications are recorded in `Space::journal` (required by the journal engine)
 
                 void from_json(const json &j);
                 void to_json(json &j) const; //!< JSON report w. statistics, output etc.
@@ -34,6 +36,7 @@ namespace Faunus {
                 void accept(Change &c);
                 void reject(Change &c);
                 virtual double bias(Change &c, double uold, double unew); //!< adds extra energy change not captured by the Hamiltonian
+                virtual bool displaces(int molid) const; //!< True if the move may change positions in molecules of type `molid` (volume scaling excluded)
         };
 
         void from_json(const json &j, Movebase &m); //!< Configure any move via json
@@ -90,7 +93,7 @@ namespace Faunus {
                         }
                     } //!< Configure via json object
 
-                    typename Tpvec::iterator randomAtom() {
+                    typename Tspace::Tgroup::iter randomAtom() {
                         assert(molid>=0);
                         auto mollist = spc.findMolecules( molid ); // all `molid` groups
                         if (size(mollist)>0) {
@@ -108,11 +111,11 @@ namespace Faunus {
                     void _move(Change &change) override {
                         auto p = randomAtom();
                         if (p!=spc.p.end()) {
-                            auto& g = spc.groups[cdata.index];
+                            spc.record(cdata.index, cdata.atoms[0]);
                             double oldcharge = p->charge;
                             p->charge = fabs(oldcharge - 1);
                             _sqd = fabs(oldcharge - 1) - oldcharge;
-                            change.groups.push_back( cdata ); // add to list of moved groups
+                            change.add( cdata ); // add to list of moved groups
                             _bias = _sqd*(pH-pKa)*ln10; // one may add bias here...
                         }
                     }
@@ -128,9 +131,13 @@ namespace Faunus {
                     AtomicSwapCharge(Tspace &spc) : spc(spc) {
                         name = "swapcharge";
                         repeat = -1; // meaning repeat N times
+                        journal = true;
                         cdata.atoms.resize(1);
                         cdata.internal=true;
+                        cdata.charge=true; // positions are untouched
                     }
+
+                    bool displaces(int) const override { return false; }
             };
 
         /**
@@ -181,7 +188,7 @@ namespace Faunus {
                         }
                     } //!< Configure via json object
 
-                    typename Tpvec::iterator randomAtom() {
+                    typename Tspace::Tgroup::iter randomAtom() {
                         assert(molid>=0);
                         //std::cout<<"molid "<<molid<<std::endl;
                         auto mollist = spc.findMolecules( molid, Tspace::ALL  ); // all `molid` groups
@@ -205,6 +212,7 @@ namespace Faunus {
                             double dp = atoms<Tparticle>.at(p->id).dp;
                             double dprot = atoms<Tparticle>.at(p->id).dprot;
                             auto& g = spc.groups[cdata.index];
+                            spc.record(cdata.index, cdata.atoms[0]);
 
                             if (dp>0) { // translate
                                 Point oldpos = p->pos;
@@ -223,7 +231,7 @@ namespace Faunus {
                             }
 
                             if (dp>0 || dprot>0)
-                                change.groups.push_back( cdata ); // add to list of moved groups
+                                change.add( cdata ); // add to list of moved groups
                         }
                         else
                             std::cerr << name << ": no atoms found" << std::endl;
@@ -236,9 +244,12 @@ namespace Faunus {
                     AtomicTranslateRotate(Tspace &spc) : spc(spc) {
                         name = "transrot";
                         repeat = -1; // meaning repeat N times
+                        journal = true;
                         cdata.atoms.resize(1);
                         cdata.internal=true;
                     }
+
+                    bool displaces(int id) const override { return id==molid; }
             };
 
         /**
@@ -293,12 +304,12 @@ namespace Faunus {
                         assert(spc.geo.getVolume()>0);
 
                         // pick random group from the system matching molecule type
-                        // TODO: This can be slow -- implement look-up-table in Space
                         auto mollist = spc.findMolecules( molid, Tspace::ACTIVE ); // list of molecules w. 'molid'
                         if (size(mollist)>0) {
                             auto it = slump.sample( mollist.begin(), mollist.end() );
                             if (!it->empty()) {
                                 assert(it->id==molid);
+                                spc.record( Faunus::distance(spc.groups.begin(), it) );
 
                                 if (dptrans>0) { // translate
                                     Point oldcm = it->cm;
@@ -318,7 +329,7 @@ namespace Faunus {
                                     Change::data d;
                                     d.index = Faunus::distance( spc.groups.begin(), it ); // integer *index* of moved group
                                     d.all = true; // *all* atoms in group were moved
-                                    change.groups.push_back( d ); // add to list of moved groups
+                                    change.add( d ); // add to list of moved groups
                                 }
                                 assert( spc.geo.sqdist( it->cm,
                                             Geometry::massCenter(it->begin(),it->end(),spc.geo.boundaryFunc,-it->cm) ) < 1e-9 );
@@ -333,7 +344,10 @@ namespace Faunus {
                     TranslateRotate(Tspace &spc) : spc(spc) {
                         name = "moltransrot";
                         repeat = -1; // meaning repeat N times
+                        journal = true;
                     }
+
+                    bool displaces(int id) const override { return id==molid && (dptrans>0 || dprot>0); }
             };
 
         /**
@@ -359,6 +373,7 @@ namespace Faunus {
                     typedef MoleculeData<Tpvec> Tmoldata;
                     RandomInserter<Tmoldata> inserter;
                     Tspace& spc; // Space to operate on
+                    Tpvec p; // new conformation; kept to reuse memory
                     int molid=-1;
                     int newconfid=-1;
 
@@ -399,12 +414,13 @@ namespace Faunus {
                             auto g = slump.sample( mollist.begin(), mollist.end() );
                             if (not g->empty()) {
                                 inserter.offset = g->cm;
-                                Tpvec p = inserter(spc.geo, spc.p, molecules<Tpvec>[molid]); // get conformation
+                                inserter(spc.geo, spc.p, molecules<Tpvec>[molid], p); // get conformation
                                 newconfid = molecules<Tpvec>[molid].getConfIndex();
 
                                 if (p.size() != g->size())
                                     throw std::runtime_error(name + ": conformation atom count mismatch");
 
+                                spc.record( Faunus::distance(spc.groups.begin(), g) );
                                 std::copy( p.begin(), p.end(), g->begin() ); // override w. new conformation
 #ifndef NDEBUG
                                 // this move shouldn't move mass centers, so let's check if this is true:
@@ -416,7 +432,7 @@ namespace Faunus {
                                 d.index = Faunus::distance(spc.groups.begin(), g); // integer *index* of moved group
                                 d.all = true; // *all* atoms in group were moved
                                 d.internal = false; // we *don't* want to calculate the internal energy
-                                change.groups.push_back( d ); // add to list of moved groups
+                                change.add( d ); // add to list of moved groups
                             }
                         }
                     }
@@ -431,8 +447,11 @@ namespace Faunus {
                     ConformationSwap(Tspace &spc) : spc(spc) {
                         name = "conformationswap";
                         repeat = -1; // meaning repeat n times
+                        journal = true;
                     }
 
+                    bool displaces(int id) const override { return id==molid; }
+
             }; // end of conformation swap move
 
 
@@ -517,6 +536,7 @@ namespace Faunus {
                                 Vold = std::pow(Vold,1.0/3.0); // volume is constant
                             Vnew = std::exp(std::log(Vold) + (slump()-0.5) * dV);
                             deltaV = Vnew-Vold;
+                            spc.recordAll();
                             spc.scaleVolume(Vnew, method->second);
                         } else deltaV=0;
                     }
@@ -528,7 +548,10 @@ namespace Faunus {
                     VolumeMove(Tspace &spc) : spc(spc) {
                         name = "volume";
                         repeat = 1;
+                        journal = true;
                     }
+
+                    bool displaces(int) const override { return false; } // volume changes are signalled by `Change::dV`
             }; // end of VolumeMove
 
         /*
@@ -646,25 +669,20 @@ namespace Faunus {
                                         throw std::runtime_error("Bad definition: One group per atomic molecule!");
                                     Change::data d;
                                     auto git = mollist.begin();
-                                    auto othermollist = otherspc->findMolecules(m.first, Tspace::ALL);  // implies that new and old are in sync
-                                    auto othergit=othermollist.begin();
                                     d.index = Faunus::distance( spc.groups.begin(), git ); // integer *index* of moved group
                                     d.internal = true;
                                     d.dNpart = true;
                                     for ( int N=0; N<m.second; N++ ) {  // deactivate m.second m.first atoms
                                         auto ait = slump.sample( git->begin(), git->end()); // iterator to random atom
-                                        // Shuffle back to end, both in trial and new
-                                        auto nait = git->end()-1; //iterator to last atom
-                                        int dist = Faunus::distance( ait, git->end() ); // distance to random atom from end
-                                        if ( Faunus::distance( ait, nait) > 1 ) {
-                                            std::iter_swap(ait, nait);
-                                            std::iter_swap(othergit->end()-dist-N, othergit->end() - (1+N) );
-                                        }
-                                        d.atoms.push_back ( Faunus::distance(git->begin(), nait) );
-                                        git->deactivate( nait, git->end());
+                                        // swapped with the last active atom; both positions are touched
+                                        d.atoms.push_back( Faunus::distance(git->begin(), ait) );
+                                        d.atoms.push_back( Faunus::distance(git->begin(), git->end()-1) );
+                                        git->swapDeactivate(ait);
                                     }
+                                    spc.updateMoleculeIndex( d.index );
                                     std::sort( d.atoms.begin(), d.atoms.end() );
-                                    change.groups.push_back( d ); // add to list of moved groups
+                                    d.atoms.erase( std::unique( d.atoms.begin(), d.atoms.end() ), d.atoms.end() );
+                                    change.add( d ); // add to list of moved groups
                                 } else {
                                     mollist = spc.findMolecules( m.first, Tspace::ACTIVE);
                                     for ( int N=0; N <m.second; N++ ) {
@@ -673,7 +691,8 @@ namespace Faunus {
                                         git->deactivate( git->begin(), git->end());
                                         d.index = Faunus::distance( spc.groups.begin(), git ); // integer *index* of moved group
                                         d.all = true; // *all* atoms in group were moved
-                                        change.groups.push_back( d ); // add to list of moved groups
+                                        change.add( d ); // add to list of moved groups
+                                        spc.updateMoleculeIndex( d.index );
                                         mollist = spc.findMolecules( m.first , Tspace::ACTIVE);
                                         // Activate/deactivate all? simply move end to front?
                                     }
@@ -689,14 +708,15 @@ namespace Faunus {
                                     d.internal = true;
                                     d.dNpart = true;
                                     for ( int N=0; N<m.second; N++ ) {  // activate m.second m.first atoms
-                                        git->activate( git->end(), git->end() + 1);
+                                        git->swapActivate( git->end() );
                                         auto ait = git->end()-1;
                                         spc.geo.randompos(ait->pos, slump);
                                         spc.geo.boundaryFunc(ait->pos);
                                         d.atoms.push_back( Faunus::distance(git->begin(), ait) );  // index of particle rel. to group
                                     }
+                                    spc.updateMoleculeIndex( d.index );
                                     std::sort( d.atoms.begin(), d.atoms.end());
-                                    change.groups.push_back( d ); // add to list of moved groups
+                                    change.add( d ); // add to list of moved groups
                                 } else {
                                     mollist = spc.findMolecules( m.first, Tspace::INACTIVE);
                                     if ( size(mollist) <  m.second ) {
@@ -715,7 +735,8 @@ namespace Faunus {
                                         git->rotate(Q, spc.geo.boundaryFunc);
                                         d.index = Faunus::distance( spc.groups.begin(), git ); // integer *index* of moved group
                                         d.all = true; // *all* atoms in group were moved
-                                        change.groups.push_back( d ); // add to list of moved groups
+                                        change.add( d ); // add to list of moved groups
+                                        spc.updateMoleculeIndex( d.index );
                                         mollist = spc.findMolecules( m.first , Tspace::INACTIVE);
                                     }
                                 }
@@ -755,6 +776,7 @@ namespace Faunus {
                     std::vector<std::string> names;
                     std::vector<int> ids;
                     std::vector<size_t> index; // all possible molecules to move
+                    std::vector<size_t> cluster, pool; // group index in cluster and of remaining candidates
 
                     void _to_json(json &j) const override {
                         using namespace u8;
@@ -783,24 +805,29 @@ namespace Faunus {
                             repeat = index.size();
                     }
 
-                    void findCluster(Tspace &spc, size_t first, std::set<size_t>& cluster) {
-                        std::set<size_t> pool(index.begin(), index.end());
+                    void findCluster(Tspace &spc, size_t first, std::vector<size_t>& cluster) {
+                        pool.clear();
+                        for (size_t i : index)
+                            if (i!=first)
+                                pool.push_back(i);
                         cluster.clear();
-                        cluster.insert(first);
-                        pool.erase(first);
-                        size_t n;
-                        do { // find cluster (not very clever...)
-                            n = cluster.size();
-                            for (size_t i : cluster)
-                                if (!spc.groups[i].empty()) // check if group is inactive
-                                    for (size_t j : pool)
-                                        if (!spc.groups[j].empty()) // check if group is inactive
-                                            if (i!=j)
-                                                if (spc.geo.sqdist(spc.groups[i].cm, spc.groups[j].cm)<=thresholdsq) {
-                                                    cluster.insert(j);
-                                                    pool.erase(j);
-                                                }
-                        } while (cluster.size()!=n);
+                        cluster.push_back(first);
+                        for (size_t k=0; k<cluster.size(); k++) { // grow cluster from each member
+                            size_t i = cluster[k];
+                            if (!spc.groups[i].empty()) // check if group is inactive
+                                for (size_t l=0; l<pool.size();) {
+                                    size_t j = pool[l];
+                                    if (!spc.groups[j].empty()) // check if group is inactive
+                                        if (spc.geo.sqdist(spc.groups[i].cm, spc.groups[j].cm)<=thresholdsq) {
+                                            cluster.push_back(j);
+                                            pool[l] = pool.back(); // remove from pool
+                                            pool.pop_back();
+                                            continue;
+                                        }
+                                    l++;
+                                }
+                        }
+                        std::sort(cluster.begin(), cluster.end());
 
                         // check if cluster is too large
                         double max = spc.geo.getLength().minCoeff()/2;
@@ -813,7 +840,6 @@ namespace Faunus {
 
                     void _move(Change &change) override {
                         if (thresholdsq>0 && !index.empty()) {
-                            std::set<size_t> cluster; // all group index in cluster
                             size_t first = *slump.sample(index.begin(), index.end()); // random molecule (nuclei)
                             findCluster(spc, first, cluster); // find cluster around first
 
@@ -829,6 +855,7 @@ namespace Faunus {
 
                             for (auto i : cluster) { // loop over molecules in cluster
                                 auto &g = spc.groups[i];
+                                spc.record(i);
 
                                 Geometry::rotate(g.begin(), g.end(), Q, spc.geo.boundaryFunc, -COM);
                                 g.cm = g.cm-COM;
@@ -838,7 +865,7 @@ namespace Faunus {
 
                                 g.translate( dp, spc.geo.boundaryFunc );
                                 d.index=i;
-                                change.groups.push_back(d);
+                                change.add( d );
                             }
                             _bias += 0; // one may add bias here...
 #ifndef NDEBUG
@@ -866,6 +893,11 @@ namespace Faunus {
                         cite = "doi:10/cj9gnn";
                         name = "cluster";
                         repeat = -1; // meaning repeat N times
+                        journal = true;
+                    }
+
+                    bool displaces(int id) const override {
+                        return (dptrans>0 || dprot>0) && std::find(ids.begin(), ids.end(), id)!=ids.end();
                     }
             };
 
@@ -931,6 +963,7 @@ namespace Faunus {
                                         i2+=offset;
 
                                         if (!index.empty()) {
+                                            spc.record( Faunus::distance(spc.groups.begin(), g) );
                                             Point oldcm = g->cm;
                                             g->unwrap(spc.geo.distanceFunc); // remove pbc
                                             Point u = (spc.p[i1].pos - spc.p[i2].pos).normalized();
@@ -950,7 +983,7 @@ namespace Faunus {
                                             Change::data d;
                                             d.index = Faunus::distance( spc.groups.begin(), g ); // integer *index* of moved group
                                             d.all = d.internal = true;    // trigger internal interactions
-                                            change.groups.push_back( d ); // add to list of moved groups
+                                            change.add( d ); // add to list of moved groups
                                         }
                                     }
                                 }
@@ -964,7 +997,10 @@ namespace Faunus {
                     Pivot(Tspace &spc) : spc(spc) {
                         name = "pivot";
                         repeat = -1; // --> repeat=N
+                        journal = true;
                     }
+
+                    bool displaces(int id) const override { return id==molid; }
             }; //!< Pivot move around random harmonic bond axis
 
 #ifdef ENABLE_MPI
@@ -994,6 +1030,7 @@ namespace Faunus {
 
                     MPI::FloatTransmitter ft;   //!< Class for transmitting floats over MPI
                     MPI::ParticleTransmitter<Tpvec> pt;//!< Class for transmitting particles over MPI
+                    Tpvec p;                      //!< Received particles; kept to reuse memory
 
                     void findPartner() {
                         int dr=0;
@@ -1028,7 +1065,6 @@ namespace Faunus {
                     void _move(Change &change) override {
                         double Vold = spc.geo.getVolume();
                         findPartner();
-                        Tpvec p; // temperary storage
                         p.resize(spc.p.size());
                         if (goodPartner()) {
                             change.all=true;
@@ -1046,6 +1082,7 @@ namespace Faunus {
                                 change.dV=true;
 
 
+                            spc.recordAll();
                             spc.p = p;
                             spc.geo.setVolume(Vnew);
 
@@ -1094,6 +1131,8 @@ namespace Faunus {
                 public:
                     ParallelTempering(Tspace &spc, MPI::MPIController &mpi ) : spc(spc), mpi(mpi) {
                         name="temper";
+                        energybias=true;
+                        journal=true;
                         partner=-1;
                         pt.recvExtra.resize(1);
                         pt.sendExtra.resize(1);
@@ -1132,6 +1171,7 @@ namespace Faunus {
                                     if (it.key()=="moltransrot") this->template push_back<Move::TranslateRotate<Tspace>>(spc);
                                     if (it.key()=="conformationswap") this->template push_back<Move::ConformationSwap<Tspace>>(spc);
                                     if (it.key()=="transrot") this->template push_back<Move::AtomicTranslateRotate<Tspace>>(spc);
+                                    if (it.key()=="swapcharge") this->template push_back<Move::AtomicSwapCharge<Tspace>>(spc);
                                     if (it.key()=="pivot") this->template push_back<Move::Pivot<Tspace>>(spc);
                                     if (it.key()=="volume") this->template push_back<Move::VolumeMove<Tspace>>(spc);
                                     if (it.key()=="speciation") this->template push_back<Move::SpeciationMove<Tspace>>(spc);
@@ -1168,13 +1208,43 @@ namespace Faunus {
                 typedef Space<Tgeometry, Tparticle> Tspace;
                 typedef typename Tspace::Tpvec Tpvec;
 
-                bool metropolis(double du) const {
+                bool metropolis(double du, double xi) const {
                     if (std::isnan(du))
                         throw std::runtime_error("Metropolis error: energy cannot be NaN");
                     if (du<0)
                         return true;
-                    return ( Move::Movebase::slump() > std::exp(-du)) ? false : true;
-                } //!< Metropolis criterion (true=accept)
+                    return ( xi > std::exp(-du)) ? false : true;
+                } //!< Metropolis criterion (true=accept) for the uniform random number `xi`
+
+                void findFixed() {
+                    std::vector<char> immobile;
+                    for (auto &m : molecules<Tpvec>)
+                        immobile.push_back( !m.atomic && std::none_of(moves.vec.begin(), moves.vec.end(),
+                                    [&](auto &mv) { return mv->repeat!=0 && mv->displaces(m.id()); }) );
+                    state1.spc.immobile = immobile;
+                    state2.spc.immobile = immobile;
+                } //!< Mark molecules that no move displaces as immobile in this simulation
+
+                static double difference(double uold, double unew) {
+                    double du = unew - uold;
+
+                    // if any energy returns NaN (from i.e. division by zero), the
+                    // configuration will always be rejected, or if moving from NaN
+                    // to a finite energy, always accepted.
+
+                    if (std::isnan(uold) and not std::isnan(unew))
+                        du = -pc::infty; // accept
+                    else if (std::isnan(unew))
+                        du = pc::infty; // reject
+
+                    // if the difference in energy is NaN (from i.e. infinity minus infinity), the
+                    // configuration will always be accepted. This should be
+                    // noted during equilibration.
+
+                    else if (std::isnan(du))
+                        du = 0; // accept
+                    return du;
+                } //!< Energy change used for acceptance; resolves NaN in either state
 
                 struct State {
                     Tspace spc;
@@ -1187,21 +1257,33 @@ namespace Faunus {
                     }
                 }; //!< Contains everything to describe a state
 
-                State state1, // old state
-                      state2; // new state (trial);
+                /*
+                 * With `journal`, a single state is used: moves record old values in
+                 * `Space::journal` before modifying the Space, `Space::undo()` toggles
+                 * between the trial and the old state for energy evaluation and is
+                 * applied once more if the move is rejected.
+                 */
+                State state1; // old state
+                std::unique_ptr<State> trial; // new state (trial) unless journaled
+                State &state2; // new state (trial); same as `state1` if journaled
                 double uinit=0, dusum=0;
                 Average<double> uavg;
+                Change change; // reused by all moves to avoid heap allocations
+                size_t nmoves=0, nallocations=0; // number of moves and heap allocations made by them
 
                 void init() {
                     dusum=0;
                     Change c; c.all=true;
 
                     state1.pot.key = Energy::Energybase::OLD; // this is the old energy (current)
-                    state2.pot.key = Energy::Energybase::NEW; // this is the new energy (trial)
+                    state1.spc.journal.enabled = !trial;
                     state1.pot.init();
 
                     uinit = state1.pot.energy(c);
+                    if (!trial)
+                        return; // journaled single state
 
+                    state2.pot.key = Energy::Energybase::NEW; // this is the new energy (trial)
                     state2.sync(state1, c);
                     state2.pot.init();
 
@@ -1239,9 +1321,22 @@ namespace Faunus {
                     return ( ufinal-(uinit+dusum) ) / uinit;
                 } //!< Calculates the relative energy drift from initial configuration
 
-                MCSimulation(const json &j, MPI::MPIController &mpi) : state1(j), state2(j), moves(j, state2.spc, mpi) {
-                    init();
-                }
+                MCSimulation(const json &j, MPI::MPIController &mpi) : state1(j),
+                    trial( j.value("journal", false) ? nullptr : new State(j) ),
+                    state2( trial ? *trial : state1 ), moves(j, state2.spc, mpi) {
+                        if (j.count("threads")==1)
+                            executor.resize( j["threads"].get<int>() );
+                        if (!trial) {
+                            for (auto &i : state1.pot.vec)
+                                if (!i->journal)
+                                    throw std::runtime_error("journal: unsupported energy term '" + i->name + "'");
+                            for (auto &i : moves.vec)
+                                if (!i->journal)
+                                    throw std::runtime_error("journal: unsupported move '" + i->name + "'");
+                        }
+                        findFixed();
+                        init();
+                    }
 
                 void store(json &j) const {
                     j = state1.spc;
@@ -1258,45 +1353,92 @@ namespace Faunus {
                     init();
                 } //!< restore system from previously store json object
 
+                void move(Move::Movebase &mv) {
+                    auto &spc = state1.spc;
+                    auto &pot = state1.pot;
+                    spc.journal.clear();
+                    mv.move(change);
+
+                    if (!change.empty()) {
+                        if (change.dNpart) // Nchem() needs both states
+                            throw std::runtime_error("journal: moves changing the number of particles are unsupported");
+                        double unew, uold, du, bias, xi = Move::Movebase::slump();
+                        bool early = pot.earlyrejection && !mv.energybias;
+                        spc.undo(change); // old state...
+                        pot.key = Energy::Energybase::OLD;
+                        uold = pot.energy(change);
+                        spc.undo(change); // ...and back to the trial state
+                        pot.key = Energy::Energybase::NEW;
+                        if (early) { // see two-state version below
+                            bias = mv.bias(change, uold, uold);
+                            if (std::isfinite(uold))
+                                pot.threshold = uold - bias - std::log(xi);
+                        }
+                        unew = pot.energy(change);
+                        pot.threshold = pc::infty;
+                        du = difference(uold, unew);
+                        if (!early)
+                            bias = mv.bias(change, uold, unew);
+
+                        bool accept = metropolis(du + bias, xi);
+                        if (!accept) {
+                            spc.undo(change); // restore old state
+                            du=0;
+                        }
+                        pot.commit(change, accept);
+                        pot.key = Energy::Energybase::OLD;
+                        if (accept)
+                            mv.accept(change);
+                        else
+                            mv.reject(change);
+                        dusum+=du; // sum of all energy changes
+                    }
+                } //!< Single move with a journaled state
+
                 void move() {
-                    Change change;
+                    size_t allocations = Faunus::allocations();
+                    nmoves += moves.repeat();
                     for (int i=0; i<moves.repeat(); i++) {
                         auto mv = moves.sample(); // pick random move
                         if (mv != moves.end() ) {
                             change.clear();
+                            if (!trial) {
+                                move(**mv);
+                                continue;
+                            }
                             (**mv).move(change);
 
                             if (!change.empty()) {
-                                double unew, uold, du;
-#pragma omp parallel sections
-                                {
-#pragma omp section
-                                    { unew = state2.pot.energy(change); }
-#pragma omp section
-                                    { uold = state1.pot.energy(change); }
+                                // xi is drawn up front so that all evaluation modes consume
+                                // the same sequence of random numbers
+                                double unew=0, uold=0, du, bias, xi = Move::Movebase::slump();
+                                bool early = state2.pot.earlyrejection && !(**mv).energybias;
+                                bool fused = !early && state2.pot.fused;
+                                if (fused) { // energy change in a single pass over both states
+                                    du = unew = state2.pot.delta(&state1.pot, change); // relative to uold=0
+                                    if (std::isnan(du))
+                                        fused = false; // redo below to resolve NaN from either state
                                 }
-
-                                du = unew - uold;
-
-                                // if any energy returns NaN (from i.e. division by zero), the
-                                // configuration will always be rejected, or if moving from NaN
-                                // to a finite energy, always accepted.
-
-                                if (std::isnan(uold) and not std::isnan(unew))
-                                    du = -pc::infty; // accept
-                                else if (std::isnan(unew))
-                                    du = pc::infty; // reject
-
-                                // if the difference in energy is NaN (from i.e. infinity minus infinity), the
-                                // configuration will always be accepted. This should be
-                                // noted during equilibration.
-
-                                else if (std::isnan(du))
-                                    du = 0; // accept
-
-                                double bias = (**mv).bias(change, uold, unew) + Nchem( state2.spc, state1.spc , change);
-
-                                if ( metropolis(du + bias) ) { // accept move
+                                if (early) {
+                                    // Draw the random number first and convert it to the largest
+                                    // trial energy that can be accepted; the trial energy evaluation
+                                    // may then stop as soon as it exceeds this threshold.
+                                    uold = state1.pot.energy(change);
+                                    bias = (**mv).bias(change, uold, uold) + Nchem( state2.spc, state1.spc , change);
+                                    if (std::isfinite(uold))
+                                        state2.pot.threshold = uold - bias - std::log(xi);
+                                    unew = state2.pot.energy(change);
+                                    state2.pot.threshold = pc::infty;
+                                } else if (!fused)
+                                    state2.pot.energy(change, state1.pot, unew, uold); // both states in parallel
+
+                                if (!fused)
+                                    du = difference(uold, unew);
+
+                                if (!early)
+                                    bias = (**mv).bias(change, uold, unew) + Nchem( state2.spc, state1.spc , change);
+
+                                if ( metropolis(du + bias, xi) ) { // accept move
                                     state1.sync( state2, change );
                                     (**mv).accept(change);
                                 }
@@ -1309,6 +1451,7 @@ namespace Faunus {
                             }
                         }
                     }
+                    nallocations += Faunus::allocations() - allocations;
                 }
 
                 void to_json(json &j) {
@@ -1316,6 +1459,14 @@ namespace Faunus {
                     j["temperature"] = pc::temperature / 1.0_K;
                     j["moves"] = moves;
                     j["energy"].push_back(state1.pot);
+                    if (executor.size()>1)
+                        j["threads"] = executor.size();
+                    if (!trial)
+                        j["journal"] = true;
+#ifdef ENABLE_ALLOCCOUNT
+                    if (nmoves>0)
+                        j["allocations/move"] = double(nallocations) / nmoves;
+#endif
                 }
         };
 
@@ -1324,6 +1475,178 @@ namespace Faunus {
             mc.to_json(j);
         }
 
+#ifdef DOCTEST_LIBRARY_INCLUDED
+    TEST_CASE("[Faunus] MCSimulation")
+    {
+        typedef Particle<Charge> Tparticle;
+        typedef MCSimulation<Geometry::Cuboid, Tparticle> Tsimulation;
+        typedef typename Space<Geometry::Cuboid, Tparticle>::Tpvec Tpvec;
+
+        // titratable site and a mobile counter-ion
+        json j = R"({
+            "atomlist": [ {"A": {"q": 1.0, "sigma": 4.0, "eps": 0.15}},
+                          {"B": {"q": -1.0, "sigma": 4.0, "eps": 0.15, "dp": 4.0}} ],
+            "moleculelist": [ {"site": {"atoms": ["A"], "atomic": true}},
+                              {"ion": {"atoms": ["B"], "atomic": true}} ],
+            "insertmolecules": [ {"site": {"N": 1}}, {"ion": {"N": 1}} ],
+            "geometry": {"length": 16},
+            "energy": [ {"nonbonded": {"default": [
+                            {"lennardjones": {"mixing": "LB"}},
+                            {"coulomb": {"type": "plain", "epsr": 80, "cutoff": 14}} ]}} ],
+            "moves": [ {"transrot": {"molecule": "ion"}},
+                       {"swapcharge": {"molecule": "site", "pH": 4.5, "pKa": 4.0}} ]
+        })"_json;
+
+        auto atoms_saved = atoms<Tparticle>;
+        auto molecules_saved = molecules<Tpvec>;
+        auto random_saved = Faunus::random;
+        auto slump_saved = Move::Movebase::slump;
+
+        // final energy and drift after a fixed number of steps from the same seeds
+        auto run = [&](const json &input) {
+            atoms<Tparticle> = input.at("atomlist").get<decltype(atoms<Tparticle>)>();
+            molecules<Tpvec> = input.at("moleculelist").get<decltype(molecules<Tpvec>)>();
+            Faunus::random = Random();
+            Move::Movebase::slump = Random();
+            Tsimulation sim(input, MPI::mpi);
+            for (int i=0; i<2000; i++)
+                sim.move();
+            Change c; c.all=true;
+            return std::make_pair( sim.pot().energy(c), sim.drift() );
+        };
+
+        json plain = j; // old and new energies evaluated separately
+        plain["energy"].push_back( {{"fused", false}} );
+        auto ref = run(plain);
+        CHECK( ref.first < 0 );
+        CHECK( std::fabs(ref.second) < 1e-9 );
+
+        auto u = run(j); // fused
+        CHECK( u.first == doctest::Approx(ref.first) );
+        CHECK( std::fabs(u.second) < 1e-9 );
+
+        json early = j;
+        early["energy"].push_back( {{"earlyrejection", true}} );
+        u = run(early);
+        CHECK( u.first == doctest::Approx(ref.first) );
+        CHECK( std::fabs(u.second) < 1e-9 );
+
+        json threads = plain;
+        threads["threads"] = 2;
+        u = run(threads);
+        executor.resize(1);
+        CHECK( u.first == doctest::Approx(ref.first) );
+        CHECK( std::fabs(u.second) < 1e-9 );
+
+        json journal = j; // single, journaled state
+        journal["journal"] = true;
+        u = run(journal);
+        CHECK( u.first == doctest::Approx(ref.first) );
+        CHECK( std::fabs(u.second) < 1e-9 );
+
+        journal["energy"].push_back( {{"earlyrejection", true}} );
+        u = run(journal);
+        CHECK( u.first == doctest::Approx(ref.first) );
+        CHECK( std::fabs(u.second) < 1e-9 );
+
+        atoms<Tparticle> = atoms_saved;
+        molecules<Tpvec> = molecules_saved;
+        Faunus::random = random_saved;
+        Move::Movebase::slump = slump_saved;
+    }
+
+    TEST_CASE("[Faunus] Moves and energies on structure-of-arrays storage")
+    {
+        typedef Particle<Charge> Tparticle;
+        typedef Space<Geometry::Cuboid, Tparticle> Tspace;
+        typedef Space<Geometry::Cuboid, Tparticle, ParticleVector<Tparticle>> Tsoaspace;
+        typedef typename Tspace::Tpvec Tpvec;
+        typedef Potential::CombinedPairPotential<Potential::CoulombGalore,Potential::WeeksChandlerAndersen<Tparticle>> Tpairpot;
+
+        auto atoms_saved = atoms<Tparticle>;
+        auto molecules_saved = molecules<Tpvec>;
+        auto slump_saved = Move::Movebase::slump;
+        atoms<Tparticle> = R"([ {"A": {"q": 1.0, "sigma": 3.0, "eps": 0.1, "dp": 2.0}},
+                                {"B": {"q": -1.0, "sigma": 3.0, "eps": 0.1, "dp": 2.0}} ])"_json.get<decltype(atoms<Tparticle>)>();
+        molecules<Tpvec> = R"([ {"salt": {"atoms": ["A","B"], "atomic": true}} ])"_json.get<decltype(molecules<Tpvec>)>();
+        json jpot = R"({"type": "plain", "epsr": 80, "cutoff": 10})"_json;
+
+        Tpvec p(60);
+        Geometry::Cuboid geo = R"( {"length": 20} )"_json;
+        Random r;
+        for (size_t i=0; i<p.size(); i++) {
+            p[i].id = i%2;
+            p[i].charge = i%2 ? -1 : 1;
+            geo.randompos(p[i].pos, r);
+        }
+
+        // Metropolis sampling with two states; returns final energy, drift and particles
+        auto run = [&](auto &spc1, auto &spc2) {
+            typedef std::decay_t<decltype(spc1)> T;
+            spc1.geo = spc2.geo = geo;
+            spc1.push_back(0, p);
+            spc2.push_back(0, p);
+            Energy::Nonbonded<T,Tpairpot> pot1(jpot, spc1), pot2(jpot, spc2);
+            Move::AtomicTranslateRotate<T> transrot(spc2);
+            Move::AtomicSwapCharge<T> swapcharge(spc2);
+            transrot.from_json( R"({"molecule": "salt"})"_json );
+            swapcharge.from_json( R"({"molecule": "salt", "pH": 7, "pKa": 7})"_json );
+            Move::Movebase::slump = Random();
+            Random accept;
+            Change c;
+            c.all = true;
+            double u = pot1.energy(c), error=0;
+            for (int i=0; i<400; i++) {
+                Move::Movebase &mv = (i%3==0) ? static_cast<Move::Movebase&>(swapcharge) : transrot;
+                mv.move(c);
+                if (!c.empty()) {
+                    double du = pot2.delta(&pot1, c); // single pass over the static particles
+                    error = std::max(error, std::fabs(du - pot2.energy(c) + pot1.energy(c)));
+                    if (accept() < std::exp(-du - mv.bias(c, 0, du))) {
+                        spc1.sync(spc2, c);
+                        pot1.sync(&pot2, c);
+                        mv.accept(c);
+                        u += du;
+                    } else {
+                        spc2.sync(spc1, c);
+                        pot2.sync(&pot1, c);
+                        mv.reject(c);
+                    }
+                }
+            }
+            c.clear();
+            c.all = true;
+            return std::make_tuple(u, u - pot1.energy(c), error, Tpvec(spc1.p));
+        };
+
+        Tspace spc1, spc2;
+        Tsoaspace soa1, soa2;
+        auto ref = run(spc1, spc2);
+        auto soa = run(soa1, soa2);
+        CHECK( std::get<2>(ref) < 1e-9 );
+        CHECK( std::get<2>(soa) < 1e-9 );
+        CHECK( std::fabs(std::get<1>(soa)) < 1e-9 );
+        CHECK( std::get<0>(soa) == doctest::Approx(std::get<0>(ref)) );
+        CHECK( std::get<3>(soa).size() == p.size() );
+        double d=0, dq=0, moved=0, titrated=0; // same trajectory in both storages
+        for (size_t i=0; i<p.size(); i++) {
+            auto &a = std::get<3>(soa)[i], &b = std::get<3>(ref)[i];
+            d += spc1.geo.sqdist(a.pos, b.pos);
+            dq += std::fabs(a.charge - b.charge);
+            moved += spc1.geo.sqdist(b.pos, p[i].pos);
+            titrated += std::fabs(b.charge - p[i].charge);
+        }
+        CHECK( d < 1e-18 );
+        CHECK( dq == 0 );
+        CHECK( moved > 0 );
+        CHECK( titrated > 0 );
+
+        atoms<Tparticle> = atoms_saved;
+        molecules<Tpvec> = molecules_saved;
+        Move::Movebase::slump = slump_saved;
+    }
+#endif
+
     /**
      * @brief add documentation.....
      *
@@ -0,0 +1,396 @@
+#pragma once
+
+#include <cassert>
+#include <vector>
+#include <array>
+#include <complex>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <Eigen/Core>
+
+namespace Faunus {
+
+    /**
+     * @brief Fast Fourier transform of a three dimensional grid
+     *
+     * Radix-2 Cooley-Tukey transform of complex data stored in
+     * row major order, i.e. index `(x*n[1] + y)*n[2] + z`.
+     *
+     * - all side lengths must be powers of two
+     * - transforms are unnormalized; `sign` is the sign of the exponent
+     * - one dimensional transforms are done on a contiguous copy of each line
+     */
+    class FFT3D {
+        public:
+            typedef std::complex<double> Tcomplex;
+
+        private:
+            std::array<int,3> n = {{0,0,0}};
+            std::array<std::vector<Tcomplex>,3> roots; // exp(2*pi*i*k/n) for each dimension
+            std::vector<Tcomplex> line;
+
+            void transform1d(Tcomplex *a, int dim, int sign) {
+                const int m = n[dim];
+                for (int i=1, j=0; i<m; i++) { // bit reversal permutation
+                    int bit = m>>1;
+                    for (; j & bit; bit>>=1)
+                        j ^= bit;
+                    j ^= bit;
+                    if (i<j)
+                        std::swap(a[i], a[j]);
+                }
+                auto &w = roots[dim];
+                for (int len=2; len<=m; len<<=1) {
+                    int step = m/len;
+                    for (int i=0; i<m; i+=len)
+                        for (int j=0; j<len/2; j++) {
+                            Tcomplex t = (sign>0) ? w[j*step] : std::conj(w[j*step]);
+                            Tcomplex u = a[i+j], v = a[i+j+len/2] * t;
+                            a[i+j] = u + v;
+                            a[i+j+len/2] = u - v;
+                        }
+                }
+            }
+
+        public:
+            static bool isPowerOfTwo(int m) { return m>0 && (m & (m-1))==0; }
+
+            void resize(const std::array<int,3> &size) {
+                const double pi = std::acos(-1.0);
+                for (int d=0; d<3; d++) {
+                    if (!isPowerOfTwo(size[d]))
+                        throw std::runtime_error("fft error: grid size must be a power of two");
+                    roots[d].resize(size[d]);
+                    for (int k=0; k<size[d]; k++)
+                        roots[d][k] = std::polar(1.0, 2*pi*k/size[d]);
+                }
+                n = size;
+                line.resize( *std::max_element(n.begin(), n.end()) );
+            }
+
+            size_t size() const { return size_t(n[0])*n[1]*n[2]; } //!< Number of grid points
+
+            void transform(std::vector<Tcomplex> &a, int sign) {
+                assert(a.size()==size());
+                const int stride[3] = {n[1]*n[2], n[2], 1};
+                for (int d=0; d<3; d++) {
+                    const int d1=(d+1)%3, d2=(d+2)%3;
+                    for (int i=0; i<n[d1]; i++)
+                        for (int j=0; j<n[d2]; j++) {
+                            size_t offset = i*stride[d1] + j*stride[d2];
+                            for (int k=0; k<n[d]; k++)
+                                line[k] = a[offset + k*stride[d]];
+                            transform1d(line.data(), d, sign);
+                            for (int k=0; k<n[d]; k++)
+                                a[offset + k*stride[d]] = line[k];
+                        }
+                }
+            } //!< In-place transform; `sign=-1` for forward, `sign=1` for inverse
+    };
+
+    /**
+     * @brief Smooth particle mesh Ewald (SPME) reciprocal space energy
+     *
+     * Charges are assigned to a periodic mesh with cardinal B-splines
+     * of order `order` and the reciprocal energy is obtained from
+     *
+     *     U = sum_m G(m) |F(m)|^2
+     *
+     * where `F` is the Fourier transform of the mesh charges and G the
+     * influence function including the B-spline moduli (Essmann et al.,
+     * doi:10/fp6h9j). The full energy is calculated with a fast Fourier
+     * transform in O(M log M) for M mesh points.
+     *
+     * Since the B-spline weights of a charge are a product of one dimensional
+     * weights, so is its contribution to F. A few changed charges can thus
+     * update F directly in O(M) and the energy change is obtained without
+     * Fourier transforms. All changed charges are handled in a single pass
+     * over the modes and the change, `dF`, is kept so that it can be undone
+     * or repeated in another mesh. Only half of the modes are stored as F is
+     * the transform of a real mesh.
+     */
+    class ParticleMesh {
+        public:
+            typedef Eigen::Vector3d Point;
+            typedef std::complex<double> Tcomplex;
+
+        private:
+            std::array<int,3> K = {{0,0,0}}; // mesh points in each dimension
+            int nz=0;                  // number of stored modes in z direction
+            int order=4;               // B-spline order
+            double alpha=0, prefactor=1;
+            Point L = {0,0,0};         // box length
+            std::array<std::vector<double>,3> bsp;       // B-spline moduli
+            std::array<std::vector<Tcomplex>,3> twiddle; // exp(-2*pi*i*k/K)
+            std::array<std::vector<Tcomplex>,3> b;       // one dimensional transforms of changed charges
+            std::vector<Tcomplex> bxy;                   // products of x and y transforms of changed charges
+            std::vector<double> G;     // influence function; doubled for modes representing a conjugate pair
+            std::vector<Tcomplex> F, dF, Q; // transformed mesh charges, change in same, and mesh charges
+            FFT3D fft;
+
+            size_t index(int x, int y, int z) const {
+                return (size_t(x)*K[1] + y)*nz + z;
+            } //!< Index in half spectrum
+
+            void splines(double w, double *M) const {
+                M[order-1] = 0;
+                M[1] = w;
+                M[0] = 1-w;
+                for (int k=3; k<=order; k++) {
+                    double div = 1.0/(k-1);
+                    M[k-1] = div*w*M[k-2];
+                    for (int j=1; j<k-1; j++)
+                        M[k-j-1] = div*( (w+j)*M[k-j-2] + (k-j-w)*M[k-j-1] );
+                    M[0] = div*(1-w)*M[0];
+                }
+            } //!< B-spline weights, `M[i] = M_n(w+n-1-i)`, for fractional coordinate w in [0,1)
+
+            void moduli() {
+                const double pi = std::acos(-1.0);
+                std::vector<double> M(order+1), Mn(order);
+                splines(0, M.data()); // M[i] = M_n(n-1-i)
+                for (int i=0; i<order; i++)
+                    Mn[i] = M[order-1-i]; // M_n(i)
+                for (int d=0; d<3; d++) {
+                    bsp[d].resize(K[d]);
+                    for (int m=0; m<K[d]; m++) {
+                        Tcomplex s(0,0);
+                        for (int k=0; k<order-1; k++)
+                            s += Mn[k+1] * std::polar(1.0, 2*pi*m*k/K[d]);
+                        bsp[d][m] = std::norm(s);
+                    }
+                    for (int m=0; m<K[d]; m++) // zeros may occur for odd orders; interpolate
+                        if (bsp[d][m] < 1e-7)
+                            bsp[d][m] = 0.5*( bsp[d][(m-1+K[d])%K[d]] + bsp[d][(m+1)%K[d]] );
+                }
+            } //!< Squared modulus of the B-spline Fourier coefficients, |b(m)|^-2
+
+        public:
+            void resize(const std::array<int,3> &mesh, int splineorder, double alpha, double prefactor=1) {
+                const double pi = std::acos(-1.0);
+                if (splineorder<3 || splineorder>16)
+                    throw std::runtime_error("pme error: spline order must be in the range [3,16]");
+                for (int d=0; d<3; d++)
+                    if (mesh[d]<splineorder)
+                        throw std::runtime_error("pme error: mesh must be larger than the spline order");
+                K = mesh;
+                nz = K[2]/2+1;
+                order = splineorder;
+                this->alpha = alpha;
+                this->prefactor = prefactor;
+                fft.resize(K);
+                for (int d=0; d<3; d++) {
+                    twiddle[d].resize(K[d]);
+                    for (int k=0; k<K[d]; k++)
+                        twiddle[d][k] = std::polar(1.0, -2*pi*k/K[d]);
+                    b[d].clear();
+                }
+                G.assign(K[0]*K[1]*nz, 0);
+                F.assign(G.size(), 0);
+                dF = F;
+                Q.assign(fft.size(), 0);
+                moduli();
+                L.setZero();
+            } //!< Set mesh size, spline order, Ewald damping parameter and energy prefactor
+
+            const std::array<int,3>& mesh() const { return K; }
+            int splineOrder() const { return order; }
+            size_t size() const { return fft.size(); } //!< Number of mesh points
+
+            void setBox(const Point &box) {
+                if (box==L)
+                    return;
+                const double pi = std::acos(-1.0);
+                L = box;
+                double V = L.prod();
+                for (int x=0; x<K[0]; x++)
+                    for (int y=0; y<K[1]; y++)
+                        for (int z=0; z<nz; z++) {
+                            Point m( (x<=K[0]/2) ? x : x-K[0], (y<=K[1]/2) ? y : y-K[1], z );
+                            Point k = 2*pi*m.cwiseQuotient(L);
+                            double k2 = k.squaredNorm();
+                            double weight = (z==0 || 2*z==K[2]) ? 1 : 2; // mode z also represents -z
+                            G[index(x,y,z)] = (x==0 && y==0 && z==0) ? 0 :
+                                weight * 2*pi*prefactor/V * std::exp(-k2/(4*alpha*alpha)) / k2 / (bsp[0][x]*bsp[1][y]*bsp[2][z]);
+                        }
+            } //!< Update influence function for a new box
+
+            template<class Tfunc>
+                void spread(const Point &pos, double q, Tfunc f) const {
+                    double M[3][16];
+                    int first[3];
+                    for (int d=0; d<3; d++) {
+                        double u = K[d] * (pos[d]/L[d] + 0.5); // fractional mesh coordinate
+                        double fl = std::floor(u);
+                        splines(u-fl, M[d]);
+                        first[d] = int(fl) - order + 1;
+                    }
+                    for (int i=0; i<order; i++) {
+                        int x = (first[0]+i) & (K[0]-1);
+                        for (int j=0; j<order; j++) {
+                            int y = (first[1]+j) & (K[1]-1);
+                            double qxy = q * M[0][i] * M[1][j];
+                            for (int k=0; k<order; k++)
+                                f(x, y, (first[2]+k) & (K[2]-1), qxy * M[2][k]);
+                        }
+                    }
+                } //!< Call `f(x,y,z,q)` for all mesh points that charge `q` at `pos` is assigned to
+
+            void clear() {
+                std::fill(Q.begin(), Q.end(), 0);
+            } //!< Remove all mesh charges
+
+            void add(const Point &pos, double q) {
+                spread(pos, q, [&](int x, int y, int z, double qi) { Q[(size_t(x)*K[1] + y)*K[2] + z] += qi; } );
+            } //!< Assign charge to the mesh; call `update()` when done
+
+            double update() {
+                fft.transform(Q, -1);
+                for (int x=0; x<K[0]; x++)
+                    for (int y=0; y<K[1]; y++)
+                        for (int z=0; z<nz; z++)
+                            F[index(x,y,z)] = Q[(size_t(x)*K[1] + y)*K[2] + z];
+                clear();
+                return energy();
+            } //!< Transform mesh charges and return the energy (complexity: M log M)
+
+            double energy() const {
+                double u=0;
+                for (size_t i=0; i<F.size(); i++)
+                    u += G[i] * std::norm(F[i]);
+                return u;
+            } //!< Reciprocal energy
+
+            double change(const std::vector<Point> &pos, const std::vector<double> &q) {
+                const size_t n = pos.size();
+                double M[16];
+                for (int d=0; d<3; d++) {
+                    const int mask = K[d]-1, len = (d==2 ? nz : K[d]);
+                    if (b[d].size() < n*len)
+                        b[d].resize(n*len);
+                    for (size_t p=0; p<n; p++) {
+                        double u = K[d] * (pos[p][d]/L[d] + 0.5);
+                        double fl = std::floor(u);
+                        splines(u-fl, M);
+                        int first = int(fl) - order + 1;
+                        Tcomplex *bp = &b[d][p*len];
+                        for (int m=0; m<len; m++) {
+                            Tcomplex s(0,0);
+                            for (int i=0; i<order; i++)
+                                s += M[i] * twiddle[d][ (m*(first+i)) & mask ];
+                            bp[m] = (d==0) ? q[p]*s : s;
+                        }
+                    }
+                }
+                if (bxy.size() < n)
+                    bxy.resize(n);
+                double du=0;
+                for (int x=0; x<K[0]; x++)
+                    for (int y=0; y<K[1]; y++) {
+                        for (size_t p=0; p<n; p++)
+                            bxy[p] = b[0][p*K[0]+x] * b[1][p*K[1]+y];
+                        size_t i = index(x,y,0);
+                        for (int z=0; z<nz; z++, i++) {
+                            Tcomplex d(0,0);
+                            for (size_t p=0; p<n; p++)
+                                d += bxy[p] * b[2][p*nz+z];
+                            du += G[i] * ( 2*(std::conj(F[i])*d).real() + std::norm(d) );
+                            F[i] += d;
+                            dF[i] = d;
+                        }
+                    }
+                return du;
+            } //!< Add charges `q` at `pos` to the transformed mesh charges and return the energy change (complexity: M per charge, single pass)
+
+            void revert() {
+                for (size_t i=0; i<F.size(); i++)
+                    F[i] -= dF[i];
+            } //!< Undo the last `change()`
+
+            void apply(const ParticleMesh &other) {
+                for (size_t i=0; i<F.size(); i++)
+                    F[i] += other.dF[i];
+            } //!< Repeat the last `change()` of `other` which must have the same setup, box and transformed mesh charges
+
+            void sync(const ParticleMesh &other) {
+                F = other.F;
+            } //!< Copy transformed mesh charges, only, from a mesh with same setup and box
+    };
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+    TEST_CASE("[Faunus] FFT3D")
+    {
+        typedef std::complex<double> T;
+        const double pi = std::acos(-1.0);
+        std::array<int,3> n = {{4,2,8}};
+        FFT3D fft;
+        fft.resize(n);
+        std::vector<T> a(fft.size()), b;
+        for (size_t i=0; i<a.size(); i++)
+            a[i] = T( std::sin(0.3*i), std::cos(1.7*i) );
+        b = a;
+        fft.transform(b, -1);
+
+        double error=0; // compare with direct transform
+        for (int u=0; u<n[0]; u++)
+            for (int v=0; v<n[1]; v++)
+                for (int w=0; w<n[2]; w++) {
+                    T s(0,0);
+                    for (int x=0; x<n[0]; x++)
+                        for (int y=0; y<n[1]; y++)
+                            for (int z=0; z<n[2]; z++)
+                                s += a[(x*n[1]+y)*n[2]+z] * std::polar(1.0, -2*pi*(double(u*x)/n[0] + double(v*y)/n[1] + double(w*z)/n[2]));
+                    error = std::max(error, std::abs(s - b[(u*n[1]+v)*n[2]+w]));
+                }
+        CHECK( error < 1e-10 );
+
+        fft.transform(b, 1); // back again
+        error=0;
+        for (size_t i=0; i<a.size(); i++)
+            error = std::max(error, std::abs(b[i]/double(fft.size()) - a[i]));
+        CHECK( error < 1e-12 );
+        CHECK_THROWS( fft.resize({{4,3,8}}) );
+    }
+
+    TEST_CASE("[Faunus] ParticleMesh")
+    {
+        using doctest::Approx;
+        typedef Eigen::Vector3d Point;
+        ParticleMesh pme;
+        pme.resize({{16,16,32}}, 5, 0.4);
+        pme.setBox({10,10,20});
+
+        std::vector<Point> pos = {{0,0,0}, {1.5,-2,3}, {-4.9,4,-9.5}, {2,2,8}};
+        std::vector<double> q = {1, -1, 0.5, -0.5};
+
+        double sum=0; // B-splines are a partition of unity
+        pme.spread(pos[1], 1.0, [&](int, int, int, double w) { sum+=w; });
+        CHECK( sum == Approx(1) );
+
+        for (size_t i=0; i<pos.size(); i++)
+            pme.add(pos[i], q[i]);
+        double u0 = pme.update();
+        CHECK( u0 == Approx(pme.energy()) );
+
+        ParticleMesh copy = pme;
+        std::vector<Point> dpos = {pos[1], pos[3]}; // move two charges
+        std::vector<double> dq = {-q[1], -q[3]};
+        pos[1] = {1.7,-1.8,3.1};
+        pos[3] = {-2,1,-8};
+        dpos.insert(dpos.end(), {pos[1], pos[3]});
+        dq.insert(dq.end(), {q[1], q[3]});
+        double du = pme.change(dpos, dq);
+        CHECK( u0+du == Approx(pme.energy()) );
+
+        copy.apply(pme); // repeat change in other mesh
+        CHECK( copy.energy() == Approx(pme.energy()) );
+        pme.revert(); // undo change
+        CHECK( pme.energy() == Approx(u0) );
+
+        for (size_t i=0; i<pos.size(); i++)
+            pme.add(pos[i], q[i]);
+        CHECK( u0+du == Approx(pme.update()) );
+    }
+#endif
+} // namespace
@@ -112,6 +112,16 @@ void Faunus::Potential::CoulombGalore::sfPlain(const Faunus::json &j, double val
     selfenergy_prefactor = 0.0;
 }
 
+void Faunus::Potential::CoulombGalore::tabulateGrid(int n) {
+    gridsize = n;
+    grid.resize(n+4);
+    for (int k=0; k<=n; k++)
+        grid[k+1] = sf.eval( table, std::max(double(k)/n, 1e-9) );
+    grid[0] = 2*grid[1] - grid[2]; // linear extrapolation of padding
+    grid[n+2] = 2*grid[n+1] - grid[n];
+    grid[n+3] = 2*grid[n+2] - grid[n+1];
+}
+
 Faunus::Potential::CoulombGalore::CoulombGalore(const std::string &name) { PairPotentialBase::name=name; }
 
 void Faunus::Potential::CoulombGalore::from_json(const Faunus::json &j) {
@@ -133,11 +143,12 @@ void Faunus::Potential::CoulombGalore::from_json(const Faunus::json &j) {
         if (type=="yukawa") sfYukawa(j);
         if (type=="fennel") sfFennel(j);
         if (type=="plain") sfPlain(j,1);
-        if (type=="ewald") sfEwald(j);
+        if (type=="ewald" || type=="ewald_pme") sfEwald(j);
         if (type=="none") sfPlain(j,0);
         if (type=="wolf") sfWolf(j);
         if ( table.empty() )
             throw std::runtime_error(name + ": unknown coulomb type '" + type + "'" );
+        tabulateGrid();
     }
 
     catch ( std::exception &e ) {
@@ -163,7 +174,7 @@ void Faunus::Potential::CoulombGalore::to_json(Faunus::json &j) const {
     }
     if (type=="qpotential")
         j["order"] = order;
-    if (type=="yonezawa" || type=="fennel" || type=="wolf" || type=="ewald")
+    if (type=="yonezawa" || type=="fennel" || type=="wolf" || type=="ewald" || type=="ewald_pme")
         j["alpha"] = alpha;
     if (type=="reactionfield") {
         if(epsrf > 1e10)
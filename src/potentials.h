@@ -21,6 +21,18 @@ namespace Faunus {
         void to_json(json &j, const PairPotentialBase &base); //!< Serialize any pair potential to json
         void from_json(const json &j, PairPotentialBase &base); //!< Serialize any pair potential from json
 
+        /**
+         * @brief True if pair potential can be evaluated from atom types, charges and squared distance
+         *
+         * Such potentials implement `operator()(int ida, int idb, double qa, double qb, double r2)`
+         * which is used by kernels operating on structure-of-arrays particle data.
+         */
+        template<class T, class=void>
+            struct hasKernel : std::false_type {};
+
+        template<class T>
+            struct hasKernel<T, decltype((void)std::declval<const T&>()(0, 0, 0.0, 0.0, 0.0))> : std::true_type {};
+
         template<class T1, class T2>
             struct CombinedPairPotential : public PairPotentialBase {
                 T1 first;  //!< First pair potential of type T1
@@ -33,6 +45,12 @@ namespace Faunus {
                         return first(a, b, r) + second(a, b, r);
                     }
 
+                template<class U1=T1, class U2=T2>
+                    inline auto operator()(int ida, int idb, double qa, double qb, double r2) const
+                    -> decltype( std::declval<const U1&>()(ida,idb,qa,qb,r2) + std::declval<const U2&>()(ida,idb,qa,qb,r2) ) {
+                        return first(ida, idb, qa, qb, r2) + second(ida, idb, qa, qb, r2);
+                    } //!< Kernel version; available only if both potentials support it
+
                 void from_json(const json &j) override {
                     first = j;
                     second = j;
@@ -147,6 +165,12 @@ namespace Faunus {
                         return m.eps(a.id,b.id) * (x*x - x);
                     }
 
+                inline double operator()(int ida, int idb, double, double, double r2) const {
+                    double x=m.s2(ida,idb)/r2; //s2/r2
+                    x=x*x*x; // s6/r6
+                    return m.eps(ida,idb) * (x*x - x);
+                } //!< Kernel version using atom types and squared distance
+
                 void to_json(json &j) const override { j = m; }
                 void from_json(const json &j) override { m = j; }
             };
@@ -174,14 +198,17 @@ namespace Faunus {
                         base::cite="doi:ct4kh9";
                     }
 
+                    inline double operator() (int ida, int idb, double, double, double r2) const {
+                        double s2=m.s2(ida,idb); // s^2
+                        double x=s2/r2;  // (s/r)^2
+                        x=x*x*x;// (s/r)^6
+                        double u=m.eps(ida,idb)*(x*x - x + onefourth);
+                        return (r2>s2*twototwosixth) ? 0 : u;
+                    } //!< Kernel version using atom types and squared distance (branchless)
+
                     template<typename... T>
                         inline double operator() (const Particle<T...> &a, const Particle<T...> &b, double r2) const {
-                            double x=m.s2(a.id,b.id); // s^2
-                            if (r2>x*twototwosixth)
-                                return 0;
-                            x=x/r2;  // (s/r)^2
-                            x=x*x*x;// (s/r)^6
-                            return m.eps(a.id,b.id)*(x*x - x + onefourth);
+                            return operator()(a.id, b.id, 0.0, 0.0, r2);
                         }
 
                     template<typename... T>
@@ -233,6 +260,9 @@ namespace Faunus {
                 double operator()(const Particle<T...> &a, const Particle<T...> &b, const Point &r) const {
                     return lB * a.charge * b.charge / r.norm();
                 }
+            inline double operator()(int, int, double qa, double qb, double r2) const {
+                return lB * qa * qb / std::sqrt(r2);
+            } //!< Kernel version using charges and squared distance
             void to_json(json &j) const override;
             void from_json(const json &j) override;
         };
@@ -249,6 +279,9 @@ namespace Faunus {
                 double operator()(const Tparticle &a, const Tparticle &b, const Point &r) const {
                     return r.squaredNorm() < d2(a.id,b.id) ? pc::infty : 0;
                 }
+                inline double operator()(int ida, int idb, double, double, double r2) const {
+                    return r2 < d2(ida,idb) ? pc::infty : 0;
+                } //!< Kernel version using atom types and squared distance
                 void to_json(json &j) const override {}
                 void from_json(const json&) override {}
             }; //!< Hardsphere potential
@@ -260,10 +293,14 @@ namespace Faunus {
             void from_json(const json &j) override;
             void to_json(json &j) const override;
 
+            inline double operator() (int, int, double, double, double r2) const {
+                double r = sqrt(r2);
+                return f / (r*r2) + e * std::pow( s/r, 12 );
+            } //!< Kernel version using squared distance
+
             template<class Tparticle>
                 double operator() (const Tparticle &a, const Tparticle &b, const Point &_r) const {
-                    double r2 = _r.squaredNorm(), r = sqrt(r2);
-                    return f / (r*r2) + e * std::pow( s/r, 12 );
+                    return operator()(a.id, b.id, 0.0, 0.0, _r.squaredNorm());
                 }
         };
 
@@ -305,15 +342,18 @@ namespace Faunus {
              * C(%, resultname = "x")
              * ~~~
              */
+            inline double operator()(int, int, double, double, double r2) const {
+                if (r2<rc2)
+                    return -eps;
+                if (r2>rcwc2)
+                    return 0;
+                double x=std::cos( c*( sqrt(r2)-rc ) );
+                return -eps*x*x;
+            } //!< Kernel version using squared distance
+
             template<typename... T>
                 double operator()(const Particle<T...> &a, const Particle<T...> &b, const Point &r) const {
-                    double r2=r.squaredNorm();
-                    if (r2<rc2)
-                        return -eps;
-                    if (r2>rcwc2)
-                        return 0;
-                    double x=std::cos( c*( sqrt(r2)-rc ) );
-                    return -eps*x*x;
+                    return operator()(a.id, b.id, 0.0, 0.0, r.squaredNorm());
                 }
 
             template<class Tparticle>
@@ -359,13 +399,16 @@ namespace Faunus {
                         j = { {"epsr",epsr} };
                     }
 
-                    double operator() (const Tparticle &a, const Tparticle &b, const Point &r) const {
-                        double r2=r.squaredNorm();
+                    inline double operator() (int ida, int idb, double qa, double qb, double r2) const {
                         double r4inv=1/(r2*r2);
-                        if (fabs(a.charge)>1e-9 or fabs(b.charge)>1e-9)
-                            return m_charged(a.id,b.id)*r4inv;
+                        if (fabs(qa)>1e-9 or fabs(qb)>1e-9)
+                            return m_charged(ida,idb)*r4inv;
                         else
-                            return m_neutral(a.id,b.id)/r2*r4inv;
+                            return m_neutral(ida,idb)/r2*r4inv;
+                    } //!< Kernel version using atom types, charges and squared distance
+
+                    double operator() (const Tparticle &a, const Tparticle &b, const Point &r) const {
+                        return operator()(a.id, b.id, a.charge, b.charge, r.squaredNorm());
                     }
 
                     Point force(const Tparticle &a, const Tparticle &b, double r2, const Point &p) {
@@ -504,6 +547,8 @@ namespace Faunus {
         class CoulombGalore : public PairPotentialBase {
             Tabulate::Andrea<double> sf; // splitting function
             Tabulate::TabulatorBase<double>::data table; // data for splitting function
+            std::vector<double> grid; // splitting function on a uniform grid in r/rc, padded by one point below and two above
+            double gridsize=0; // number of grid intervals in [0,1]
             std::function<double(double)> calcDielectric; // function for dielectric const. calc.
             std::string type;
             double selfenergy_prefactor;
@@ -519,12 +564,33 @@ namespace Faunus {
             void sfEwald(const json &j);
             void sfWolf(const json &j);
             void sfPlain(const json &j, double val=1);
+            void tabulateGrid(int n=4096);
+
+            /*
+             * Catmull-Rom interpolation on a uniform grid. Unlike the spline in `table`,
+             * no search is needed and there are no branches, so that the kernel below
+             * can be vectorized. Arguments beyond one are clamped. The scalar
+             * operators use the spline.
+             */
+            inline double splitting(double x) const {
+                double t = std::min(x, 1.0) * gridsize;
+                int k = int(t);
+                t -= k;
+                const double *p = grid.data() + k; // f(k-1), f(k), f(k+1), f(k+2)
+                return p[1] + 0.5*t*( p[2]-p[0] + t*( 2*p[0]-5*p[1]+4*p[2]-p[3] + t*( 3*(p[1]-p[2])+p[3]-p[0] ) ) );
+            } //!< Splitting function at x=r/rc
 
             public:
             CoulombGalore(const std::string &name="coulomb");
 
             void from_json(const json &j) override;
 
+            inline double operator()(int, int, double qa, double qb, double r2) const {
+                double r = std::sqrt(r2);
+                double u = lB * qa * qb / r * splitting( r*rc1i );
+                return (r2 < rc2) ? u : 0;
+            } //!< Kernel version using charges and squared distance (branchless)
+
             template<class Tparticle>
                 double operator()(const Tparticle &a, const Tparticle &b, double r2) const {
                     if (r2 < rc2) {
@@ -579,9 +645,10 @@ namespace Faunus {
             class FunctorPotential : public PairPotentialBase {
                 typedef std::function<double(const T&, const T&, const Point&)> uFunc;
                 PairMatrix<uFunc,true> umatrix; // matrix with potential for each atom pair
+                PairMatrix<uFunc,true> qmatrix; // as `umatrix` but with charge dependent potentials only
                 json _j; // storage for input json
 
-                uFunc combineFunc(const json &j) const {
+                uFunc combineFunc(const json &j, bool charged=false) const {
                     uFunc u = [](const T&a, const T&b, const Point &r){return 0.0;};
                     if (j.is_array()) {
                         for (auto &i : j) // loop over all defined potentials in array
@@ -598,10 +665,11 @@ namespace Faunus {
                                     if (it.key()=="wca") _u = WeeksChandlerAndersen<T>() = i;
                                     if (it.key()=="pm") _u = Coulomb() + HardSphere<T>() = it.value();
                                     if (it.key()=="pmwca") _u = Coulomb() + WeeksChandlerAndersen<T>() = it.value();
-                                    if (_u!=nullptr) // if found, sum them into new function object
-                                        u = [u,_u](const T&a, const T&b, const Point &r){return u(a,b,r)+_u(a,b,r);};
-                                    else
+                                    if (_u==nullptr)
                                         throw std::runtime_error("unknown pair-potential: " + it.key());
+                                    if (charged && it.key()!="coulomb" && it.key()!="polar" && it.key()!="pm" && it.key()!="pmwca")
+                                        continue; // skip potentials that do not depend on charges
+                                    u = [u,_u](const T&a, const T&b, const Point &r){return u(a,b,r)+_u(a,b,r);}; // sum into new function object
                                 }
                     } else
                         throw std::runtime_error("dictionary of potentials required");
@@ -618,21 +686,349 @@ namespace Faunus {
                     return umatrix(a.id, b.id)(a, b, r);
                 }
 
+                double electrostatic(const T &a, const T &b, const Point &r) const {
+                    return qmatrix(a.id, b.id)(a, b, r);
+                } //!< Charge dependent part of the potential
+
                 void to_json(json &j) const override { j = _j; }
 
                 void from_json(const json &j) override {
                     _j = j;
                     umatrix = decltype(umatrix)( atoms<T>.size(), combineFunc(j.at("default")) );
+                    qmatrix = decltype(qmatrix)( atoms<T>.size(), combineFunc(j.at("default"), true) );
                     for (auto it=j.begin(); it!=j.end(); ++it) {
                         auto atompair = words2vec<std::string>(it.key()); // is this for a pair of atoms?
                         if (atompair.size()==2) {
                             auto ids = names2ids(atoms<T>, atompair);
                             umatrix.set(ids[0], ids[1], combineFunc(it.value()));
+                            qmatrix.set(ids[0], ids[1], combineFunc(it.value(), true));
                         }
                     }
                 }
             };
 
+        /**
+         * @brief Arbitrary potentials for specific atom types using closed-set dispatch
+         *
+         * Same input and result as `FunctorPotential`, but pair potentials are stored by
+         * value in pools, one for each potential type, and each atom pair holds a flat list
+         * of tags (type and pool index). Evaluation is a single loop over the tags with a
+         * `switch` so that the potentials can be inlined.
+         * To add a potential, extend `Type`, `add()` and `operator()`.
+         */
+        template<class T /** particle type */>
+            class SwitchPotential : public PairPotentialBase {
+                enum Type {COULOMB, COS2, POLAR, HARDSPHERE, LENNARDJONES, REPULSIONR3, WCA, PM, PMWCA};
+                struct Tag {
+                    Type type;
+                    int index; // index in pool of given type
+                };
+                typedef std::vector<Tag> Ttags;
+
+                std::vector<CoulombGalore> coulomb;
+                std::vector<CosAttract> cos2;
+                std::vector<Polarizability<T>> polar;
+                std::vector<HardSphere<T>> hardsphere;
+                std::vector<LennardJones<T>> lennardjones;
+                std::vector<RepulsionR3> repulsionr3;
+                std::vector<WeeksChandlerAndersen<T>> wca;
+                std::vector<CombinedPairPotential<Coulomb,HardSphere<T>>> pm;
+                std::vector<CombinedPairPotential<Coulomb,WeeksChandlerAndersen<T>>> pmwca;
+
+                PairMatrix<Ttags,true> tmatrix; // tags for each atom pair
+                json _j; // storage for input json
+
+                template<class Tpot>
+                    void add(Ttags &tags, Type type, std::vector<Tpot> &pool, const json &j) {
+                        pool.emplace_back();
+                        pool.back() = j;
+                        tags.push_back( {type, int(pool.size())-1} );
+                    }
+
+                Ttags combine(const json &j) {
+                    Ttags tags;
+                    if (j.is_array()) {
+                        for (auto &i : j) // loop over all defined potentials in array
+                            if (i.is_object() && (i.size()==1))
+                                for (auto it=i.begin(); it!=i.end(); ++it) {
+                                    if (it.key()=="coulomb") add(tags, COULOMB, coulomb, i);
+                                    else if (it.key()=="cos2") add(tags, COS2, cos2, i);
+                                    else if (it.key()=="polar") add(tags, POLAR, polar, i);
+                                    else if (it.key()=="hardsphere") add(tags, HARDSPHERE, hardsphere, i);
+                                    else if (it.key()=="lennardjones") add(tags, LENNARDJONES, lennardjones, i);
+                                    else if (it.key()=="repulsionr3") add(tags, REPULSIONR3, repulsionr3, i);
+                                    else if (it.key()=="wca") add(tags, WCA, wca, i);
+                                    else if (it.key()=="pm") add(tags, PM, pm, it.value());
+                                    else if (it.key()=="pmwca") add(tags, PMWCA, pmwca, it.value());
+                                    else
+                                        throw std::runtime_error("unknown pair-potential: " + it.key());
+                                }
+                    } else
+                        throw std::runtime_error("dictionary of potentials required");
+                    return tags;
+                } // parse json array of potentials to a list of tags
+
+                public:
+
+                SwitchPotential(const std::string &name="") {
+                    PairPotentialBase::name = name;
+                }
+
+                double operator()(const T &a, const T &b, const Point &r) const {
+                    double u=0;
+                    for (auto &t : tmatrix(a.id, b.id))
+                        switch (t.type) {
+                            case COULOMB:      u += coulomb[t.index](a, b, r); break;
+                            case COS2:         u += cos2[t.index](a, b, r); break;
+                            case POLAR:        u += polar[t.index](a, b, r); break;
+                            case HARDSPHERE:   u += hardsphere[t.index](a, b, r); break;
+                            case LENNARDJONES: u += lennardjones[t.index](a, b, r); break;
+                            case REPULSIONR3:  u += repulsionr3[t.index](a, b, r); break;
+                            case WCA:          u += wca[t.index](a, b, r); break;
+                            case PM:           u += pm[t.index](a, b, r); break;
+                            case PMWCA:        u += pmwca[t.index](a, b, r); break;
+                        }
+                    return u;
+                }
+
+                double operator()(int ida, int idb, double qa, double qb, double r2) const {
+                    double u=0;
+                    for (auto &t : tmatrix(ida, idb))
+                        switch (t.type) {
+                            case COULOMB:      u += coulomb[t.index](ida, idb, qa, qb, r2); break;
+                            case COS2:         u += cos2[t.index](ida, idb, qa, qb, r2); break;
+                            case POLAR:        u += polar[t.index](ida, idb, qa, qb, r2); break;
+                            case HARDSPHERE:   u += hardsphere[t.index](ida, idb, qa, qb, r2); break;
+                            case LENNARDJONES: u += lennardjones[t.index](ida, idb, qa, qb, r2); break;
+                            case REPULSIONR3:  u += repulsionr3[t.index](ida, idb, qa, qb, r2); break;
+                            case WCA:          u += wca[t.index](ida, idb, qa, qb, r2); break;
+                            case PM:           u += pm[t.index](ida, idb, qa, qb, r2); break;
+                            case PMWCA:        u += pmwca[t.index](ida, idb, qa, qb, r2); break;
+                        }
+                    return u;
+                } //!< Kernel version; potentials are dispatched for each pair and thus not vectorized
+
+                double electrostatic(const T &a, const T &b, const Point &r) const {
+                    double u=0;
+                    for (auto &t : tmatrix(a.id, b.id))
+                        switch (t.type) {
+                            case COULOMB:      u += coulomb[t.index](a, b, r); break;
+                            case POLAR:        u += polar[t.index](a, b, r); break;
+                            case PM:           u += pm[t.index](a, b, r); break;
+                            case PMWCA:        u += pmwca[t.index](a, b, r); break;
+                            default:           break; // independent of charges
+                        }
+                    return u;
+                } //!< Charge dependent part of the potential
+
+                bool bilinear(int ida, int idb) const {
+                    for (auto &t : tmatrix(ida, idb))
+                        if (t.type==POLAR)
+                            return false;
+                    return true;
+                } //!< True if the potential for the atom pair has the form `u0(r) + qa*qb*w(r)`
+
+                void to_json(json &j) const override { j = _j; }
+
+                void from_json(const json &j) override {
+                    _j = j;
+                    coulomb.clear();
+                    cos2.clear();
+                    polar.clear();
+                    hardsphere.clear();
+                    lennardjones.clear();
+                    repulsionr3.clear();
+                    wca.clear();
+                    pm.clear();
+                    pmwca.clear();
+                    tmatrix = decltype(tmatrix)( atoms<T>.size(), combine(j.at("default")) );
+                    for (auto it=j.begin(); it!=j.end(); ++it) {
+                        auto atompair = words2vec<std::string>(it.key()); // is this for a pair of atoms?
+                        if (atompair.size()==2) {
+                            auto ids = names2ids(atoms<T>, atompair);
+                            tmatrix.set(ids[0], ids[1], combine(it.value()));
+                        }
+                    }
+                }
+            };
+
+        /**
+         * @brief Spline tabulated version of `SwitchPotential`
+         *
+         * For each atom type pair, the potential is split into a charge independent part,
+         * `u0(r)`, and a coefficient, `w(r)`, so that `u = u0 + qa*qb*w` with charges taken
+         * from the particles at runtime. Both are tabulated as a function of the squared
+         * distance, from just below the cutoff and inwards until `rmin` or until the magnitude
+         * exceeds `umax`. Outside the table the analytic potential is used and beyond the
+         * cutoff the energy is zero. Atom pairs with potentials that are not of this form
+         * (polarizability) are always evaluated analytically.
+         */
+        template<class T /** particle type */>
+            class SplinedPotential : public SwitchPotential<T> {
+                typedef SwitchPotential<T> base;
+                typedef typename Tabulate::TabulatorBase<double>::data Ttable;
+                struct Tables {
+                    Ttable u0, w;
+                    bool analytic=true; // true if not tabulated
+                };
+                Tabulate::Andrea<double> spline;
+                PairMatrix<Tables,true> tables; // tables for each atom pair
+                double rc2=0, rmin=0.5, utol=1e-5, umax=100;
+                double maxerror=0; // max. absolute deviation from analytic potential
+                size_t memory=0; // bytes used by tables
+
+                Tables tabulate(T a, T b) {
+                    Tables t;
+                    if (!base::bilinear(a.id, b.id))
+                        return t;
+                    T a1=a, b1=b; // unit charges
+                    a.charge = b.charge = 0;
+                    a1.charge = b1.charge = 1;
+                    auto u0 = [&](double r2) { return base::operator()(a, b, {std::sqrt(r2),0,0}); };
+                    auto w = [&](double r2) {
+                        Point r(std::sqrt(r2),0,0);
+                        return base::electrostatic(a1, b1, r) - base::electrostatic(a, b, r);
+                    };
+                    double rc = std::sqrt(rc2), dr = 0.01, rlow = rmin;
+                    for (double r=rc; r>rmin; r-=dr) { // lower limit where potential is well behaved
+                        double x = u0(r*r), y = w(r*r);
+                        if (!std::isfinite(x) || !std::isfinite(y) || std::fabs(x)>umax || std::fabs(y)>umax) {
+                            rlow = std::min(r+2*dr, rc-dr);
+                            break;
+                        }
+                    }
+                    t.u0 = spline.generate(u0, rlow*rlow, std::pow(rc-dr, 2)); // stay clear of the cutoff
+                    t.w = spline.generate(w, rlow*rlow, std::pow(rc-dr, 2));
+                    t.analytic = false;
+                    auto sample = [&](const Ttable &f, std::function<double(double)> func) {
+                        double rmintab = std::sqrt(f.rmin2), rmaxtab = std::sqrt(f.rmax2);
+                        for (int i=1; i<=1000; i++) { // sample error within table
+                            double r = rmintab + i*(rmaxtab-rmintab)/1000;
+                            maxerror = std::max(maxerror, std::fabs( spline.eval(f, r*r) - func(r*r) ));
+                        }
+                        memory += (f.r2.size() + f.c.size()) * sizeof(double);
+                    };
+                    sample(t.u0, u0);
+                    sample(t.w, w);
+                    return t;
+                }
+
+                inline const Tables* lookup(const T &a, const T &b, double r2) const {
+                    auto &t = tables(a.id, b.id);
+                    if (!t.analytic && r2 > t.u0.rmin2 && r2 <= t.u0.rmax2 && r2 > t.w.rmin2 && r2 <= t.w.rmax2)
+                        return &t;
+                    return nullptr;
+                } //!< Tables for atom pair if `r2` is within them; nullptr if not
+
+                public:
+
+                SplinedPotential(const std::string &name="") : base(name) {}
+
+                double operator()(const T &a, const T &b, const Point &r) const {
+                    double r2 = r.squaredNorm();
+                    if (r2 < rc2) {
+                        if (auto t = lookup(a, b, r2)) {
+                            double qq = a.charge * b.charge;
+                            return spline.eval(t->u0, r2) + (qq!=0 ? qq*spline.eval(t->w, r2) : 0);
+                        }
+                        return base::operator()(a, b, r); // outside table
+                    }
+                    return 0;
+                }
+
+                double electrostatic(const T &a, const T &b, const Point &r) const {
+                    double r2 = r.squaredNorm();
+                    if (r2 < rc2) {
+                        if (auto t = lookup(a, b, r2)) {
+                            double qq = a.charge * b.charge;
+                            return qq!=0 ? qq*spline.eval(t->w, r2) : 0;
+                        }
+                        return base::electrostatic(a, b, r);
+                    }
+                    return 0;
+                } //!< Charge dependent part of the potential
+
+                void to_json(json &j) const override {
+                    base::to_json(j);
+                    j["spline"] = {
+                        {"utol", utol}, {"umax", umax}, {"rmin", rmin},
+                        {"max error", maxerror}, {"memory (kB)", memory/1024.0}
+                    };
+                    _roundjson(j["spline"], 4);
+                }
+
+                void from_json(const json &j) override {
+                    base::from_json(j);
+                    rc2 = std::pow( j.at("cutoff").get<double>(), 2 );
+                    utol = j.value("utol", utol);
+                    umax = j.value("umax", umax);
+                    rmin = j.value("rmin", rmin);
+                    spline.setTolerance(utol);
+                    maxerror = 0;
+                    memory = 0;
+                    tables = decltype(tables)( atoms<T>.size() );
+                    for (auto &i : atoms<T>)
+                        for (auto &k : atoms<T>)
+                            if (k.id()<=i.id()) {
+                                T a = i.p, b = k.p;
+                                a.id = i.id();
+                                b.id = k.id();
+                                tables.set(a.id, b.id, tabulate(a, b));
+                            }
+                }
+            };
+
+        /**
+         * @brief Charge dependent part of a pair potential
+         *
+         * If only charges change, terms that depend on atom types and distances only are
+         * unaffected and can be skipped. Potentials that are independent of charges return
+         * zero while combined potentials sum their charge dependent parts. Unless overloaded
+         * below, the full potential is returned.
+         */
+        template<class Tpot, class T>
+            double electrostatic(const Tpot &pot, const T &a, const T &b, const Point &r) {
+                return pot(a, b, r);
+            }
+
+        template<class T>
+            double electrostatic(const LennardJones<T>&, const T&, const T&, const Point&) { return 0; }
+
+        template<class T>
+            double electrostatic(const WeeksChandlerAndersen<T>&, const T&, const T&, const Point&) { return 0; }
+
+        template<class T>
+            double electrostatic(const HardSphere<T>&, const T&, const T&, const Point&) { return 0; }
+
+        template<class T>
+            double electrostatic(const CosAttract&, const T&, const T&, const Point&) { return 0; }
+
+        template<class T>
+            double electrostatic(const RepulsionR3&, const T&, const T&, const Point&) { return 0; }
+
+        template<class T>
+            double electrostatic(const Dummy&, const T&, const T&, const Point&) { return 0; }
+
+        template<class T1, class T2, class T>
+            double electrostatic(const CombinedPairPotential<T1,T2> &pot, const T &a, const T &b, const Point &r) {
+                return electrostatic(pot.first, a, b, r) + electrostatic(pot.second, a, b, r);
+            }
+
+        template<class T>
+            double electrostatic(const FunctorPotential<T> &pot, const T &a, const T &b, const Point &r) {
+                return pot.electrostatic(a, b, r);
+            }
+
+        template<class T>
+            double electrostatic(const SwitchPotential<T> &pot, const T &a, const T &b, const Point &r) {
+                return pot.electrostatic(a, b, r);
+            }
+
+        template<class T>
+            double electrostatic(const SplinedPotential<T> &pot, const T &a, const T &b, const Point &r) {
+                return pot.electrostatic(a, b, r);
+            }
+
 #ifdef DOCTEST_LIBRARY_INCLUDED
         TEST_CASE("[Faunus] FunctorPotential")
         {
@@ -673,6 +1069,48 @@ namespace Faunus {
             CHECK( u(a,b,r) == Approx( coulomb(a,b,r) + wca(a,b,r) ) );
             CHECK( u(c,c,r*1.01) == 0 );
             CHECK( u(c,c,r*0.99) == pc::infty );
+            CHECK( u.electrostatic(a,b,r) == Approx( coulomb(a,b,r) ) );
+            CHECK( u.electrostatic(c,c,r*0.99) == 0 );
+            CHECK( electrostatic(wca, a, b, r) == 0 );
+
+            SUBCASE("SwitchPotential") {
+                SwitchPotential<T> v = json(u);
+                std::vector<T> p = {a, b, c};
+                for (auto &i : p)
+                    for (auto &j : p)
+                        for (double x : {0.5, 1.5, 2.0, 3.0, 10.0}) {
+                            CHECK( v(i,j,r*x) == u(i,j,r*x) ); // identical arithmetic
+                            CHECK( v.electrostatic(i,j,r*x) == u.electrostatic(i,j,r*x) );
+                        }
+                CHECK( json(v) == json(u) );
+                CHECK_THROWS( v = R"({ "default": [ {"nosuchpotential": {}} ] })"_json );
+            }
+
+            SUBCASE("SplinedPotential") {
+                json in = u;
+                in["cutoff"] = 15;
+                in["utol"] = 1e-6;
+                SplinedPotential<T> v = in;
+                std::vector<T> p = {a, b, c};
+                for (auto &i : p)
+                    for (auto &j : p)
+                        for (double x : {0.4, 0.7, 1.5, 2.0, 3.0, 7.4}) {
+                            double ref = u(i,j,r*x);
+                            if (std::isfinite(ref))
+                                CHECK( v(i,j,r*x) == Approx(ref).epsilon(1e-5) );
+                            else
+                                CHECK( v(i,j,r*x) == ref ); // overlap; below table
+                        }
+                CHECK( v(a,b,r*8) == 0 ); // beyond cutoff
+
+                T a2 = a; // charges are taken from particles, not the atom list
+                a2.charge = -0.5;
+                CHECK( v(a2,b,r*2) == Approx( u(a2,b,r*2) ).epsilon(1e-5) );
+                CHECK( Potential::electrostatic(v,a2,b,r*2) == Approx( u.electrostatic(a2,b,r*2) ).epsilon(1e-5) );
+                json out = v;
+                CHECK( out["spline"]["max error"] <= 1e-6 );
+                CHECK( out["spline"]["memory (kB)"] > 0 );
+            }
         }
 #endif
 
@@ -921,6 +1359,33 @@ namespace Faunus {
                 CHECK( pot(a,b,{2.5,0,0})== Approx( f * 71.74894965974514 ) ); // partial overlap
             }
         }
+
+        TEST_CASE("[Faunus] CoulombGalore")
+        {
+            typedef Particle<Charge> T;
+            T a, b;
+            a.charge = 1;
+            b.charge = -1;
+            double rc = 12;
+            json params = R"({ "plain": {}, "none": {}, "fanourgakis": {}, "qpotential": {"order": 3},
+                "ewald": {"alpha": 0.25}, "wolf": {"alpha": 0.25}, "fennel": {"alpha": 0.25},
+                "yonezawa": {"alpha": 0.25}, "yukawa": {"debyelength": 10}, "reactionfield": {"eps_rf": 100} })"_json;
+
+            // the kernel interpolates the splitting function on a grid; compare with the spline
+            for (auto it=params.begin(); it!=params.end(); ++it) {
+                json j = it.value();
+                j["type"] = it.key();
+                j["cutoff"] = rc;
+                j["epsr"] = 80;
+                CoulombGalore pot;
+                pot.from_json(j);
+                double lB = pc::lB(80), error=0;
+                for (double r=0.5; r<rc; r+=0.0137)
+                    error = std::max(error, std::fabs( pot(a.id, b.id, a.charge, b.charge, r*r) - pot(a, b, r*r) ) * r/lB);
+                CHECK( error < 1e-7 );
+                CHECK( pot(a.id, b.id, a.charge, b.charge, rc*rc+1e-6) == 0 );
+            }
+        }
 #endif
 
     }//end of namespace Potential
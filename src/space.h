@@ -3,6 +3,7 @@
 #include "geometry.h"
 #include "group.h"
 #include "molecule.h"
+#include "celllist.h"
 
 namespace Faunus {
 
@@ -23,7 +24,8 @@ namespace Faunus {
             int index; //!< Touched group index
             bool internal=false; //!< True is the internal energy/config has changed
             bool all=false; //!< Set to `true` if all particles in group have been updated
-            std::vector<int> atoms; //!< Touched atom index w. respect to `Group::begin()`
+            bool charge=false; //!< Set to `true` if only charges of the particles have changed
+            std::vector<int> atoms; //!< Touched atom index w. respect to `Group::begin()`; if `dNpart`, also inactive positions
 
             inline bool operator<( const data & a ) const{
                 return index < a.index;
@@ -31,6 +33,17 @@ namespace Faunus {
         }; //!< Properties of changed groups
 
         std::vector<data> groups; //!< Touched groups by index in group vector
+        std::vector<std::vector<int>> spare; //!< Memory for `data::atoms` kept from previous changes
+
+        data& add(const data &d) {
+            groups.emplace_back();
+            if (!spare.empty()) {
+                groups.back().atoms.swap( spare.back() );
+                spare.pop_back();
+            }
+            groups.back() = d; // copies into already allocated memory if possible
+            return groups.back();
+        } //!< Add touched group, reusing memory from cleared changes
 
         auto touchedGroupIndex() {
             // skitfunktion
@@ -43,6 +56,11 @@ namespace Faunus {
             dV=false;
             all=false;
             dNpart=false;
+            for (auto &d : groups) // keep memory for later use by `add()`
+                if (d.atoms.capacity()>0 && spare.size()<groups.capacity()) {
+                    d.atoms.clear();
+                    spare.push_back( std::move(d.atoms) );
+                }
             groups.clear();
             assert(empty());
         } //!< Clear all change data
@@ -60,19 +78,357 @@ namespace Faunus {
 
     };
 
+    /**
+     * @brief Structure-of-arrays copy of particle positions, charges and types
+     *
+     * Allows pair kernels to stream through contiguous memory
+     * which the compiler can vectorize.
+     */
+    struct ParticleArrays {
+        std::vector<double> x, y, z, charge;
+        std::vector<int> id;
+        bool enabled=false; //!< True if kept up-to-date by `Space`
+
+        static constexpr int stride=1; //!< Distance between the coordinates of consecutive particles
+        size_t size() const { return x.size(); }
+        const double* coordinates(int d) const { return d==0 ? x.data() : (d==1 ? y.data() : z.data()); }
+        const double* charges() const { return charge.data(); }
+        const int* ids() const { return id.data(); }
+
+        template<class Tparticle>
+            inline void set(size_t i, const Tparticle &a) {
+                x[i] = a.pos.x();
+                y[i] = a.pos.y();
+                z[i] = a.pos.z();
+                charge[i] = a.charge;
+                id[i] = a.id;
+            } //!< Copy particle to index i
+
+        template<class Tpvec>
+            void update(const Tpvec &p) {
+                x.resize(p.size());
+                y.resize(p.size());
+                z.resize(p.size());
+                charge.resize(p.size());
+                id.resize(p.size());
+                for (size_t i=0; i<p.size(); i++)
+                    set(i, p[i]);
+                enabled = true;
+            } //!< Copy all particles
+    };
+
+    /**
+     * @brief Structure-of-arrays storage for point charges
+     *
+     * Alternative to `std::vector<Tparticle>` as particle storage in `Space`,
+     * _e.g._ `Space<Geometry::Cuboid, Particle<Charge>, ParticleVector<Particle<Charge>>>`.
+     * Ids, positions, weights and charges are kept in separate, contiguous arrays so
+     * that pair kernels stream positions, charges and ids only. Elements are accessed
+     * through proxies whose members refer into the arrays; code written as
+     * `auto &&i = p[k]; i.pos += d;` or `it->charge` works with both storages.
+     * Assigning one proxy to another copies values and `swap()` exchanges them, so the
+     * container can be sorted and rotated by the standard algorithms.
+     *
+     * Data is exchanged with `std::vector<Tparticle>` at I/O boundaries:
+     *
+     * ```{.cpp}
+     *     ParticleVector<Particle<Charge>> v;
+     *     v = p;                               // std::vector --> SoA
+     *     std::vector<Particle<Charge>> q = v; // SoA --> std::vector
+     * ```
+     *
+     * Unlike for `std::vector`, iterators refer to the container and an index and
+     * remain valid when particles are appended.
+     */
+    template<class Tparticle>
+        class ParticleVector {
+            static_assert(sizeof(Point)==3*sizeof(double), "positions must be contiguous");
+            public:
+                std::vector<int> id;
+                std::vector<Point> pos;
+                std::vector<double> mw, charge;
+
+                template<bool Const>
+                    struct proxy {
+                        template<class T> using ref = typename std::conditional<Const, const T&, T&>::type;
+                        ref<int> id;
+                        ref<Point> pos;
+                        ref<double> mw;
+                        ref<double> charge;
+
+                        proxy(ref<int> id, ref<Point> pos, ref<double> mw, ref<double> charge)
+                            : id(id), pos(pos), mw(mw), charge(charge) {}
+                        proxy(const proxy&)=default;
+
+                        proxy& operator=(const proxy &a) {
+                            id = a.id;
+                            pos = a.pos;
+                            mw = a.mw;
+                            charge = a.charge;
+                            return *this;
+                        } //!< Copy values, not references
+
+                        proxy& operator=(const Tparticle &a) {
+                            id = a.id;
+                            pos = a.pos;
+                            mw = a.mw;
+                            charge = a.charge;
+                            return *this;
+                        } //!< Scatter particle
+
+                        operator Tparticle() const {
+                            Tparticle a;
+                            a.id = id;
+                            a.pos = pos;
+                            a.mw = mw;
+                            a.charge = charge;
+                            return a;
+                        } //!< Gather particle
+
+                        operator proxy<true>() const { return {id, pos, mw, charge}; }
+
+                        void rotate(const Eigen::Quaterniond&, const Eigen::Matrix3d&) {} //!< Point charges have no internal coordinates
+
+                        friend void swap(proxy a, proxy b) { Tparticle t = a; a = b; b = t; }
+                        friend void swap(proxy a, Tparticle &b) { Tparticle t = a; a = b; b = t; }
+                        friend void swap(Tparticle &a, proxy b) { swap(b, a); }
+                    }; //!< Reference to a particle
+
+                typedef proxy<false> reference;
+                typedef proxy<true> const_reference;
+                typedef Tparticle value_type;
+
+                template<bool Const>
+                    class basic_iterator {
+                        private:
+                            typedef typename std::conditional<Const, const ParticleVector, ParticleVector>::type Tvec;
+                            Tvec *v=nullptr;
+                            std::ptrdiff_t i=0;
+                        public:
+                            typedef std::random_access_iterator_tag iterator_category;
+                            typedef Tparticle value_type;
+                            typedef std::ptrdiff_t difference_type;
+                            typedef proxy<Const> reference;
+                            struct pointer {
+                                reference r;
+                                reference* operator->() { return &r; }
+                            }; //!< Result of `operator->()`
+
+                            basic_iterator()=default;
+                            basic_iterator(Tvec *v, difference_type i) : v(v), i(i) {}
+                            operator basic_iterator<true>() const { return {v, i}; }
+
+                            reference operator*() const { return (*v)[i]; }
+                            pointer operator->() const { return {(*v)[i]}; }
+                            reference operator[](difference_type n) const { return (*v)[i+n]; }
+                            basic_iterator& operator++() { ++i; return *this; }
+                            basic_iterator& operator--() { --i; return *this; }
+                            basic_iterator operator++(int) { auto t=*this; ++i; return t; }
+                            basic_iterator operator--(int) { auto t=*this; --i; return t; }
+                            basic_iterator& operator+=(difference_type n) { i+=n; return *this; }
+                            basic_iterator& operator-=(difference_type n) { i-=n; return *this; }
+                            basic_iterator operator+(difference_type n) const { return {v, i+n}; }
+                            basic_iterator operator-(difference_type n) const { return {v, i-n}; }
+                            friend basic_iterator operator+(difference_type n, const basic_iterator &a) { return a+n; }
+                            difference_type operator-(const basic_iterator &o) const { return i-o.i; }
+                            bool operator==(const basic_iterator &o) const { return v==o.v && i==o.i; }
+                            bool operator!=(const basic_iterator &o) const { return !(*this==o); }
+                            bool operator<(const basic_iterator &o) const { return i<o.i; }
+                            bool operator>(const basic_iterator &o) const { return i>o.i; }
+                            bool operator<=(const basic_iterator &o) const { return i<=o.i; }
+                            bool operator>=(const basic_iterator &o) const { return i>=o.i; }
+                    }; //!< Random access iterator yielding proxies
+
+                typedef basic_iterator<false> iterator;
+                typedef basic_iterator<true> const_iterator;
+
+                ParticleVector()=default;
+                explicit ParticleVector(const std::vector<Tparticle> &p) { *this = p; }
+
+                ParticleVector& operator=(const std::vector<Tparticle> &p) {
+                    clear();
+                    insert(end(), p.begin(), p.end());
+                    return *this;
+                } //!< Copy from vector of particles
+
+                operator std::vector<Tparticle>() const {
+                    return std::vector<Tparticle>(begin(), end());
+                } //!< Copy to vector of particles
+
+                size_t size() const { return id.size(); }
+                bool empty() const { return id.empty(); }
+
+                reference operator[](size_t i) { return {id[i], pos[i], mw[i], charge[i]}; }
+                const_reference operator[](size_t i) const { return {id[i], pos[i], mw[i], charge[i]}; }
+
+                reference at(size_t i) {
+                    if (i>=size())
+                        throw std::out_of_range("ParticleVector::at");
+                    return (*this)[i];
+                }
+
+                reference front() { return (*this)[0]; }
+                reference back() { return (*this)[size()-1]; }
+
+                iterator begin() { return {this, 0}; }
+                iterator end() { return {this, std::ptrdiff_t(size())}; }
+                const_iterator begin() const { return {this, 0}; }
+                const_iterator end() const { return {this, std::ptrdiff_t(size())}; }
+
+                void reserve(size_t n) {
+                    id.reserve(n);
+                    pos.reserve(n);
+                    mw.reserve(n);
+                    charge.reserve(n);
+                }
+
+                void resize(size_t n, const Tparticle &a=Tparticle()) {
+                    static_assert(std::is_same<Tparticle, Particle<Charge>>::value,
+                            "ParticleVector stores id, position, weight and charge only");
+                    id.resize(n, a.id);
+                    pos.resize(n, a.pos);
+                    mw.resize(n, a.mw);
+                    charge.resize(n, a.charge);
+                }
+
+                void clear() { resize(0); }
+
+                void push_back(const Tparticle &a) {
+                    resize(size()+1, a);
+                }
+
+                template<class Titer>
+                    iterator insert(iterator it, Titer first, Titer last) {
+                        if (it!=end())
+                            throw std::runtime_error("ParticleVector: insertion only at end");
+                        size_t n = size();
+                        reserve( n + std::distance(first, last) );
+                        for (; first!=last; ++first)
+                            push_back(*first);
+                        return begin()+n;
+                    } //!< Append particles; `it` must be `end()`
+
+                static constexpr int stride=3; //!< Distance between the coordinates of consecutive particles
+                const double* coordinates(int d) const { return reinterpret_cast<const double*>(pos.data())+d; }
+                const double* charges() const { return charge.data(); }
+                const int* ids() const { return id.data(); }
+        };
+
+    template<class Tparticle>
+        void to_json(json &j, const ParticleVector<Tparticle> &p) {
+            j = std::vector<Tparticle>(p);
+        }
+
+    template<class Tparticle>
+        void from_json(const json &j, ParticleVector<Tparticle> &p) {
+            p = j.get<std::vector<Tparticle>>();
+        }
+
+    template<class Tparticle>
+        const ParticleArrays& particleArrays(const std::vector<Tparticle>&, const ParticleArrays &soa) {
+            assert(soa.enabled);
+            return soa;
+        } //!< Arrays read by pair kernels: the structure-of-arrays shadow...
+
+    template<class Tparticle>
+        const ParticleVector<Tparticle>& particleArrays(const ParticleVector<Tparticle> &p, const ParticleArrays&) {
+            return p;
+        } //!< ...or the storage itself
+
+    /**
+     * @brief Index of groups by molecule id and activity
+     *
+     * For each molecule id, vectors with the index of all, of active and
+     * of inactive groups, allowing counting and random selection in constant
+     * time. Moving a group between the active and inactive lists is O(1)
+     * as the position in its list is stored for each group.
+     */
+    struct MoleculeIndex {
+        std::vector<std::vector<int>> all, active, inactive; //!< Group index for each molecule id
+        std::vector<int> id;         //!< Molecule id of each group when indexed
+        std::vector<int> position;   //!< Position of each group in `active` or `inactive`
+        std::vector<char> isactive;  //!< Activity of each group when indexed
+        std::vector<int> empty;      //!< No groups; for ids that are not indexed
+
+        void clear() {
+            all.clear();
+            active.clear();
+            inactive.clear();
+            id.clear();
+            position.clear();
+            isactive.clear();
+        }
+
+        void insert(int i, int molid, bool act) {
+            if (i>=int(id.size())) {
+                id.resize(i+1, -1);
+                position.resize(i+1);
+                isactive.resize(i+1);
+            }
+            id[i] = molid;
+            if (molid<0)
+                return; // groups without molecule id are not indexed
+            if (molid>=int(all.size())) {
+                all.resize(molid+1);
+                active.resize(molid+1);
+                inactive.resize(molid+1);
+            }
+            auto &v = act ? active[molid] : inactive[molid];
+            isactive[i] = act;
+            position[i] = v.size();
+            v.push_back(i);
+        } //!< Add group `i` to the active or inactive list (the list of all groups is kept by the caller)
+
+        void erase(int i) {
+            if (id[i]<0)
+                return;
+            auto &v = isactive[i] ? active[id[i]] : inactive[id[i]];
+            int last = v.back();
+            v[position[i]] = last; // move last element into the vacant position
+            position[last] = position[i];
+            v.pop_back();
+        } //!< Remove group `i` from its active or inactive list
+
+        void update(int i, int molid, bool act) {
+            if (id[i]==molid && isactive[i]==act)
+                return;
+            erase(i);
+            if (id[i]!=molid) {
+                if (id[i]>=0) {
+                    auto &v = all[id[i]];
+                    v.erase( std::find(v.begin(), v.end(), i) );
+                }
+                insert(i, molid, act);
+                if (molid>=0) {
+                    auto &w = all[molid];
+                    w.insert( std::upper_bound(w.begin(), w.end(), i), i ); // sorted by group index
+                }
+            } else
+                insert(i, molid, act);
+        } //!< Update group `i` after a change of activity (O(1)) or of molecule id
+    };
+
     struct SpaceBase {
         virtual Geometry::GeometryBase& getGeometry()=0;
         virtual void clear()=0;
         virtual void scaleVolume(double Vnew, Geometry::VolumeMethod method=Geometry::ISOTROPIC)=0;
     };
 
-    template<class Tgeometry, class Tparticletype>
+    /**
+     * @brief Particles, groups and geometry
+     *
+     * Particles are stored in `std::vector<Tparticle>` unless another storage is given,
+     * _e.g._ the structure-of-arrays `ParticleVector`. `Tpvec` is always a vector of
+     * particles and is used for topology, insertion and I/O.
+     */
+    template<class Tgeometry, class Tparticletype, class Tstoragetype=std::vector<Tparticletype>>
         struct Space {
 
             typedef Tparticletype Tparticle;
-            typedef Space<Tgeometry,Tparticle> Tspace;
+            typedef Tstoragetype Tstorage;
+            typedef Space<Tgeometry,Tparticle,Tstorage> Tspace;
             typedef std::vector<Tparticle> Tpvec;
-            typedef Group<Tparticle> Tgroup;
+            typedef Group<Tparticle, typename Tstorage::iterator> Tgroup;
             typedef std::vector<Tgroup> Tgvec;
             typedef Change Tchange;
 
@@ -84,12 +440,59 @@ namespace Faunus {
             std::vector<ChangeTrigger> changeTriggers; //!< Call when a Change object is applied
             std::vector<SyncTrigger> onSyncTriggers;   //!< Call when two Space objects are synched
 
-            Tpvec p;       //!< Particle vector
+            Tstorage p;    //!< Particle vector
             Tgvec groups;  //!< Group vector
             Tgeometry geo; //!< Container geometry
 
+            CellList<> cmgrid;             //!< Grid with mass centers of active molecular groups
+            double cmgridcutoff=0;         //!< Minimum cell size of `cmgrid`; zero if disabled
+            std::vector<int> atomicgroups; //!< Index of atomic groups (updated with `cmgrid`)
+            size_t cmgridsize=0;           //!< Number of groups when `cmgrid` was built
+
+            ParticleArrays soa;            //!< Structure-of-arrays shadow of `p`; enabled by `updateArrays()` unless `p` is itself stored as arrays
+            MoleculeIndex molindex;        //!< Groups by molecule id and activity; see `updateMoleculeIndex()`
+            std::vector<int> particlegroup; //!< Index of the group owning each particle; -1 if none
+            size_t particlegroupsize=0;    //!< Number of groups when `particlegroup` was built
+            std::vector<char> immobile;    //!< Molecule ids that no move displaces in this simulation
+
+            /**
+             * @brief Old values of the particles and groups modified by a move
+             *
+             * When enabled, moves record particles and group properties before modifying
+             * them so that a single Space can describe both the current and the trial
+             * state: `undo()` exchanges recorded and current values and thereby toggles
+             * between the two. Entries are a superset of what changed.
+             */
+            struct Journal {
+                struct GroupData {
+                    int index, size, id, confid;
+                    bool atomic;
+                    int atoms; // number of recorded particles; -1 if all
+                    Point cm;
+                };
+                bool enabled=false;          //!< Record modifications; required by the journal engine
+                bool all=false;              //!< Everything, including the geometry, is recorded
+                Tpvec p;                     //!< Recorded particles...
+                std::vector<int> index;      //!< ...their index in `Space::p`...
+                std::vector<int> group;      //!< ...and the index of their group; empty if `all`
+                std::vector<GroupData> groups; //!< Recorded group properties
+                Tgeometry geo;               //!< Recorded geometry if `all`
+                std::vector<char> recorded;  //!< True for particles in `index`; indexed as `Space::p`
+
+                void clear() {
+                    for (int k : index)
+                        recorded[k] = false;
+                    all=false;
+                    p.clear();
+                    index.clear();
+                    group.clear();
+                    groups.clear();
+                }
+            };
+            Journal journal; //!< Old values of particles and groups modified by the current move
+
             auto positions() const {
-               return ranges::view::transform(p, [](auto &i) -> const Point& {return i.pos;});
+               return ranges::view::transform(p, [](auto &&i) -> const Point& {return i.pos;});
             } //!< Iterable range with positions 
 
             enum Selection {ALL, ACTIVE, INACTIVE};
@@ -97,8 +500,17 @@ namespace Faunus {
             void clear() {
                 p.clear();
                 groups.clear();
+                molindex.clear();
+                particlegroup.clear();
+                particlegroupsize=0;
             } //!< Clears particle and molecule list
 
+            bool isFixed(int molid) const {
+                auto &m = molecules<Tpvec>;
+                return molid>=0 && molid<(int)m.size()
+                    && ( m[molid].fixed || (molid<(int)immobile.size() && immobile[molid]) );
+            } //!< True if molecules of the given id are never displaced (topology or `immobile`)
+
             /*
              * The following is considered:
              *
@@ -128,39 +540,182 @@ namespace Faunus {
 
                     groups.push_back(g);
                     assert( in.size() == groups.back().capacity() );
+                    updateMoleculeIndex( groups.size()-1 );
+                    if (particlegroup.size()+in.size()==p.size() && particlegroupsize+1==groups.size()) {
+                        particlegroup.resize(p.size(), groups.size()-1);
+                        particlegroupsize++;
+                    }
                 }
             } //!< Safely add particles and corresponding group to back
 
-            auto findMolecules(int molid, Selection sel=ACTIVE) {
-                std::function<bool(Tgroup&)> f;
+            /*
+             * The molecule index is kept up-to-date by `push_back()`, `sync()` and
+             * `undo()`. Code that otherwise resizes groups, _e.g._ by activating or
+             * deactivating particles, must call `updateMoleculeIndex(i)` for the
+             * resized group. If the number of groups differs from the index, it is
+             * rebuilt upon next use.
+             */
+            void updateMoleculeIndex() {
+                molindex.clear();
+                for (size_t i=0; i<groups.size(); i++) {
+                    auto &g = groups[i];
+                    molindex.insert(i, g.id, g.size()==g.capacity());
+                    if (g.id>=0)
+                        molindex.all[g.id].push_back(i);
+                }
+            } //!< Rebuild molecule index (complexity: order G)
+
+            void updateMoleculeIndex(int i) {
+                auto &g = groups.at(i);
+                if (molindex.id.size()==groups.size())
+                    molindex.update(i, g.id, g.size()==g.capacity());
+                else if (molindex.id.size()+1==groups.size() && i+1==int(groups.size())) { // appended group
+                    molindex.insert(i, g.id, g.size()==g.capacity());
+                    if (g.id>=0)
+                        molindex.all[g.id].push_back(i);
+                } else
+                    updateMoleculeIndex();
+            } //!< Update molecule index for group `i` (complexity: order 1 unless the molecule id changed)
+
+            void updateMoleculeIndex(const Tchange &change) {
+                if (change.all || molindex.id.size()!=groups.size())
+                    updateMoleculeIndex();
+                else if (change.dNpart)
+                    for (auto &d : change.groups)
+                        updateMoleculeIndex(d.index);
+            } //!< Update molecule index for changed groups
+
+            const std::vector<int>& moleculeIndex(int molid, Selection sel=ACTIVE) {
+                if (molindex.id.size()!=groups.size())
+                    updateMoleculeIndex();
+                if (molid<0 || molid>=int(molindex.all.size()))
+                    return molindex.empty;
                 switch (sel) {
                     case (ALL):
-                        f = [molid](Tgroup &i){ return i.id==molid; };
-                        break;
+                        return molindex.all[molid];
                     case (INACTIVE):
-                        f = [molid](Tgroup &i){ return (i.id==molid) && (i.size()!=i.capacity()); };
-                        break;
-                    case (ACTIVE):
-                        f = [molid](Tgroup &i){ return (i.id==molid) && (i.size()==i.capacity()); };
-                        break;
+                        return molindex.inactive[molid];
+                    default:
+                        return molindex.active[molid];
                 }
-                return groups | ranges::view::filter(f);
-            } //!< Range with all groups of type `molid` (complexity: order N)
+            } //!< Index of groups of type `molid`; all groups are sorted by index while active and inactive are unordered
+
+            auto findMolecules(int molid, Selection sel=ACTIVE) {
+                return ranges::view::transform( moleculeIndex(molid, sel),
+                        [this](int i) -> Tgroup& { return groups[i]; } );
+            } //!< Random access range with groups of type `molid` (complexity: order 1)
 
             typename decltype(groups)::iterator randomMolecule(int molid, Random &rand, Selection sel=ACTIVE) {
-                auto m = findMolecules(molid, sel);
-                if (size(m)>0)
-                    return groups.begin() + (&*rand.sample( m.begin(), m.end() ) - &*groups.begin());
+                auto &v = moleculeIndex(molid, sel);
+                if (!v.empty())
+                    return groups.begin() + *rand.sample( v.begin(), v.end() );
                 return groups.end();
             } //!< Random group; groups.end() if not found
 
+            void updateMassCenterGrid(double cutoff=0) {
+                cmgridcutoff = std::max(cmgridcutoff, cutoff);
+                if (cmgridcutoff>0) {
+                    cmgrid.resize(geo, cmgridcutoff);
+                    atomicgroups.clear();
+                    cmgridsize = groups.size();
+                    for (size_t i=0; i<groups.size(); i++)
+                        if (groups[i].atomic)
+                            atomicgroups.push_back(i);
+                        else if (!groups[i].empty())
+                            cmgrid.insert(i, cmgrid.index( cmgrid.p2c(groups[i].cm) ));
+                }
+            } //!< Enable and/or rebuild mass center grid with cells no smaller than `cutoff` (complexity: order G)
+
+            void updateMassCenterGrid(const Tchange &change) {
+                if (cmgridcutoff>0) {
+                    if (change.all || change.dV || change.dNpart || cmgridsize!=groups.size())
+                        updateMassCenterGrid();
+                    else
+                        for (auto &d : change.groups) {
+                            auto &g = groups[d.index];
+                            if (!g.atomic && !d.charge)
+                                cmgrid.move(d.index, cmgrid.index( cmgrid.p2c(g.cm) ));
+                        }
+                }
+            } //!< Update mass center grid for changed groups, if enabled
+
+            void updateArrays() {
+                if (std::is_same<Tstorage,Tpvec>::value)
+                    soa.update(p);
+            } //!< Enable and/or rebuild structure-of-arrays shadow of all particles (complexity: order N)
+
+            auto& arrays() const {
+                return particleArrays(p, soa);
+            } //!< Positions, charges and ids as arrays for pair kernels; see `ParticleArrays`
+
+            void updateArrays(const Tchange &change) {
+                if (soa.enabled) {
+                    if (change.all || change.dV || change.dNpart || soa.x.size()!=p.size())
+                        updateArrays();
+                    else
+                        for (auto &d : change.groups) {
+                            auto &g = groups[d.index];
+                            size_t first = g.begin()-p.begin();
+                            if (d.all || d.atoms.empty())
+                                for (size_t i=first; i<first+g.size(); i++)
+                                    soa.set(i, p[i]);
+                            else
+                                for (int i : d.atoms)
+                                    soa.set(first+i, p[first+i]);
+                        }
+                }
+            } //!< Update structure-of-arrays shadow for changed particles, if enabled
+
+            template<class Tfunc>
+                void forEachGroupNear(int i, Tfunc f) const {
+                    if (cmgridcutoff>0 && !groups[i].atomic) {
+                        for (int j : atomicgroups)
+                            f(j);
+                        cmgrid.forEachNeighbor( cmgrid.index( cmgrid.p2c(groups[i].cm) ),
+                                [&](int j){ if (j!=i) f(j); } );
+                    } else
+                        for (int j=0; j<(int)groups.size(); j++)
+                            if (j!=i)
+                                f(j);
+                } //!< Call `f(j)` for all groups `j!=i` that are atomic or have mass centers closer than `cmgridcutoff` to group `i`
+
             auto findAtoms(int atomid) const {
-                return p | ranges::view::filter( [atomid](auto &i){ return i.id==atomid; } );
+                return p | ranges::view::filter( [atomid](auto &&i){ return i.id==atomid; } );
             } //!< Range with all atoms of type `atomid` (complexity: order N)
 
+            /*
+             * Groups own a fixed range of particles given by their capacity, so the
+             * particle-to-group table is unaffected by activation and deactivation and
+             * only needs to be rebuilt when groups are added or replaced. This is
+             * detected from the number of particles and groups, and `push_back()`
+             * extends the table in place.
+             */
+            void updateParticleGroupIndex() {
+                particlegroup.assign(p.size(), -1);
+                for (size_t k=0; k<groups.size(); k++) {
+                    int first = groups[k].begin()-p.begin();
+                    std::fill( particlegroup.begin()+first, particlegroup.begin()+first+groups[k].capacity(), k );
+                }
+                particlegroupsize = groups.size();
+            } //!< Rebuild particle-to-group table (complexity: order N)
+
+            auto findGroupContaining(size_t j) {
+                if (j<p.size()) {
+                    if (particlegroup.size()!=p.size() || particlegroupsize!=groups.size())
+                        updateParticleGroupIndex();
+                    int k = particlegroup[j];
+                    if (k>=0 && j < size_t(groups[k].end()-p.begin()))
+                        return groups.begin()+k;
+                }
+                return groups.end();
+            } //!< Finds the group containing the j'th particle in its active range (complexity: order 1)
+
             auto findGroupContaining(const Tparticle &i) {
-                return std::find_if( groups.begin(), groups.end(), [&i](auto &g){ return g.contains(i); });
-            } //!< Finds the groups containing the given atom
+                std::less<const Tparticle*> less; // total order, also for pointers outside `p`
+                if (!less(&i, p.data()) && less(&i, p.data()+p.size()))
+                    return findGroupContaining( size_t(&i - p.data()) );
+                return groups.end();
+            } //!< Finds the group containing the given atom in its active range (complexity: order 1)
 
             void sync(Tspace &other, const Tchange &change) {
 
@@ -175,6 +730,8 @@ namespace Faunus {
                     p = other.p; // copy all positions
                     assert( p.begin() != other.p.begin() && "deep copy problem");
                     groups = other.groups;
+                    particlegroup = other.particlegroup;
+                    particlegroupsize = other.particlegroupsize;
 
                     if (not groups.empty())
                         if (groups.front().begin() == other.p.begin())
@@ -187,6 +744,16 @@ namespace Faunus {
                         auto &g = groups.at(m.index);  // old group
                         auto &gother = other.groups.at(m.index);// new group
 
+                        if (m.charge) { // copy only charges
+                            if (m.all || m.atoms.empty())
+                                for (size_t i=0; i<g.size(); i++)
+                                    (g.begin()+i)->charge = (gother.begin()+i)->charge;
+                            else
+                                for (auto i : m.atoms)
+                                    (g.begin()+i)->charge = (gother.begin()+i)->charge;
+                            continue;
+                        }
+
                         g.shallowcopy(gother); // copy group data but *not* particles
 
                         if (m.all) // copy all particles
@@ -198,8 +765,86 @@ namespace Faunus {
                 }
                 assert( p.size() == other.p.size() );
                 assert( p.begin() != other.p.begin());
+
+                updateMassCenterGrid(change);
+                updateArrays(change);
+                updateMoleculeIndex(change);
             } //!< Copy differing data from other (o) Space using Change object
 
+            void record(int i, int atom=-1) {
+                if (!journal.enabled || journal.all)
+                    return;
+                auto &g = groups.at(i);
+                auto it = std::find_if(journal.groups.begin(), journal.groups.end(),
+                        [i](auto &d){ return d.index==i; });
+                if (it==journal.groups.end()) {
+                    journal.groups.push_back( {i, int(g.size()), g.id, g.confid, g.atomic, 0, g.cm} );
+                    it = journal.groups.end()-1;
+                }
+                if (it->atoms<0)
+                    return;
+                int first = g.begin()-p.begin();
+                if (journal.recorded.size() < p.size())
+                    journal.recorded.resize(p.size(), false);
+                auto add = [&](int k) {
+                    journal.recorded[k] = true;
+                    journal.p.push_back( p[k] );
+                    journal.index.push_back( k );
+                    journal.group.push_back( i );
+                };
+                if (atom<0) { // all particles, including inactive ones
+                    for (int k=first; k<first+int(g.capacity()); k++)
+                        if (!journal.recorded[k])
+                            add(k);
+                    it->atoms = -1;
+                } else if (!journal.recorded[first+atom]) {
+                    add(first+atom);
+                    it->atoms++;
+                }
+            } //!< Record group `i` or a single atom (index relative to group) before modification, if journal is enabled
+
+            void recordAll() {
+                if (journal.enabled && !journal.all) {
+                    journal.clear();
+                    journal.all = true;
+                    journal.p = p;
+                    journal.geo = geo;
+                    for (size_t i=0; i<groups.size(); i++) {
+                        auto &g = groups[i];
+                        journal.groups.push_back( {int(i), int(g.size()), g.id, g.confid, g.atomic, -1, g.cm} );
+                    }
+                }
+            } //!< Record everything before modification, if journal is enabled
+
+            void undo(const Tchange &change) {
+                if (journal.all) {
+                    std::swap_ranges(p.begin(), p.end(), journal.p.begin());
+                    Tgeometry tmp;
+                    tmp = geo;
+                    geo = journal.geo;
+                    journal.geo = tmp;
+                } else
+                    for (size_t k=0; k<journal.index.size(); k++) {
+                        using std::swap; // proxies of structure-of-arrays storage swap by value
+                        swap( p[journal.index[k]], journal.p[k] );
+                    }
+                for (auto &d : journal.groups) {
+                    auto &g = groups[d.index];
+                    int size = g.size();
+                    g.resize(d.size);
+                    d.size = size;
+                    std::swap(g.id, d.id);
+                    std::swap(g.confid, d.confid);
+                    std::swap(g.atomic, d.atomic);
+                    std::swap(g.cm, d.cm);
+                    if (d.size!=int(g.size()) || d.id!=g.id)
+                        updateMoleculeIndex(d.index);
+                }
+                updateMassCenterGrid(change);
+                updateArrays(change);
+                updateMoleculeIndex(change);
+            } //!< Exchange journal and current values; toggles between the trial and the old state
+
             /*
              * Scales:
              * - positions of free atoms
@@ -216,12 +861,12 @@ namespace Faunus {
                 for (auto& g : groups) {
                     if (!g.empty()) {
                         if (g.atomic) // scale all atoms
-                            for (auto& i : g)
+                            for (auto &&i : g)
                                 i.pos = i.pos.cwiseProduct(scale);
                         else { // scale mass center and translate
                             Point delta = g.cm.cwiseProduct(scale) - g.cm;
                             g.cm = g.cm.cwiseProduct(scale);
-                            for (auto &i : g) {
+                            for (auto &&i : g) {
                                 i.pos += delta;
                                 geo.boundary(i.pos);
                             }
@@ -237,6 +882,11 @@ namespace Faunus {
                 if (method==Geometry::ISOCHORIC)
                     Vold = std::pow(Vold,1./3.);
 
+                if (cmgridcutoff>0)
+                    updateMassCenterGrid();
+                if (soa.enabled)
+                    updateArrays();
+
                 for (auto f : scaleVolumeTriggers)
                     f(*this, Vold, Vnew);
             } //!< scale space to new volume
@@ -250,7 +900,7 @@ namespace Faunus {
                 };
                 auto& _j = j["groups"];
                 for (auto &i : groups) {
-                    auto& name = molecules<decltype(p)>.at(i.id).name;
+                    auto& name = molecules<Tpvec>.at(i.id).name;
                     json tmp, d=i;
                     d.erase("cm");
                     d.erase("id");
@@ -261,7 +911,7 @@ namespace Faunus {
                     _j.push_back( tmp );
                 }
                 auto& _j2 = j["reactionlist"];
-                for (auto &i : reactions<decltype(p)>) {
+                for (auto &i : reactions<Tpvec>) {
                     // auto name = i.name;
                     json tmp, d = i;
                     // tmp[name] = d;
@@ -272,18 +922,18 @@ namespace Faunus {
 
         }; //!< Space for particles, groups, geometry
 
-    template<class Tgeometry, class Tparticle>
-        void to_json(json &j, Space<Tgeometry,Tparticle> &spc) {
-            typedef typename Space<Tgeometry,Tparticle>::Tpvec Tpvec;
+    template<class Tgeometry, class Tparticle, class Tstorage>
+        void to_json(json &j, Space<Tgeometry,Tparticle,Tstorage> &spc) {
+            typedef typename Space<Tgeometry,Tparticle,Tstorage>::Tpvec Tpvec;
             j["geometry"] = spc.geo;
             j["groups"] = spc.groups;
             j["particles"] = spc.p;
             j["reactionlist"] = reactions<Tpvec>;
         } //!< Serialize Space to json object
 
-    template<class Tgeometry, class Tparticletype>
-        void from_json(const json &j, Space<Tgeometry,Tparticletype> &spc) {
-            typedef typename Space<Tgeometry,Tparticletype>::Tpvec Tpvec;
+    template<class Tgeometry, class Tparticletype, class Tstorage>
+        void from_json(const json &j, Space<Tgeometry,Tparticletype,Tstorage> &spc) {
+            typedef typename Space<Tgeometry,Tparticletype,Tstorage>::Tpvec Tpvec;
             using namespace std::string_literals;
 
             try {
@@ -304,7 +954,7 @@ namespace Faunus {
                     spc.p = j.at("particles").get<Tpvec>();
                     if (!spc.p.empty()) {
                         auto begin = spc.p.begin();
-                        Group<Tparticletype> g(begin,begin);
+                        typename Space<Tgeometry,Tparticletype,Tstorage>::Tgroup g(begin,begin);
                         for (auto &i : j.at("groups")) {
                             g.begin() = begin;
                             from_json(i, g);
@@ -314,6 +964,7 @@ namespace Faunus {
                         if (begin != spc.p.end())
                             throw std::runtime_error("load error");
                     }
+                    spc.updateMoleculeIndex();
                 }
                 // check correctness of molecular mass centers
                 for (auto &i : spc.groups)
@@ -365,13 +1016,17 @@ namespace Faunus {
                                     }
                                     assert(!p.empty());
                                     spc.push_back(mol->id(), p);
-                                    if (inactive)
+                                    if (inactive) {
                                         spc.groups.back().resize(0);
+                                        spc.updateMoleculeIndex( spc.groups.size()-1 );
+                                    }
                                 } else {
                                     while ( cnt-- > 0 ) { // insert molecules
                                         spc.push_back(mol->id(), mol->getRandomConformation(spc.geo, spc.p));
-                                        if (inactive)
+                                        if (inactive) {
                                             spc.groups.back().resize(0);
+                                            spc.updateMoleculeIndex( spc.groups.size()-1 );
+                                        }
                                     }
                                     // load specific positions for the N added molecules
                                     bool success=false;
@@ -407,6 +1062,150 @@ namespace Faunus {
         } //!< Insert `N` molecules into space as defined in `insert`
 
 #ifdef DOCTEST_LIBRARY_INCLUDED
+    TEST_CASE("[Faunus] ParticleVector")
+    {
+        typedef Particle<Charge> Tparticle;
+        std::vector<Tparticle> p(4);
+        for (size_t i=0; i<p.size(); i++) {
+            p[i].id = i;
+            p[i].pos = {double(i), 0, -1};
+            p[i].charge = 1.0 - i;
+            p[i].mw = 2;
+        }
+
+        ParticleVector<Tparticle> v(p); // std::vector --> SoA
+        CHECK( v.size()==4 );
+        CHECK( v.coordinates(0)[3*2] == 2 );
+        CHECK( v.coordinates(2)[3*2] == -1 );
+        CHECK( v.charges()[3] == -2 );
+        CHECK( v[1].mw == 2 );
+
+        v[0].pos += Point(0,1,0); // proxies refer to the arrays
+        v.begin()->charge = 0.5;
+        CHECK( v.pos[0].y() == 1 );
+        CHECK( v.charge[0] == 0.5 );
+
+        v[1] = v[2]; // values, not references, are copied
+        v[2].id = 7;
+        CHECK( v.id[1] == 2 );
+        v[1] = p[1];
+        CHECK( v.id[1] == 1 );
+
+        using std::swap;
+        swap(v[0], v[3]);
+        CHECK( v.id[0] == 3 );
+        CHECK( v.id[3] == 0 );
+        CHECK( v.pos[3].y() == 1 );
+        Tparticle a = p[2];
+        swap(v[2], a);
+        CHECK( v.id[2] == 2 );
+        CHECK( a.id == 7 );
+
+        auto it = v.begin();
+        CHECK( (*it++).id == 3 );
+        CHECK( (it--)->id == 1 );
+        CHECK( it == v.begin() );
+        CHECK( v.end()-v.begin() == 4 );
+        CHECK( v.begin()+4 == v.end() );
+        CHECK( v.end() > v.begin() );
+        CHECK( v.begin() <= v.begin() );
+        CHECK( v.end() >= v.begin()+2 );
+
+        std::sort(v.begin(), v.end(), [](const Tparticle &a, const Tparticle &b) { return a.id<b.id; });
+        CHECK( v.id == std::vector<int>({0,1,2,3}) );
+        CHECK( v.pos[0].y() == 1 );
+        CHECK( v.charge[0] == 0.5 );
+        std::rotate(v.begin(), v.begin()+1, v.end());
+        CHECK( v.id == std::vector<int>({1,2,3,0}) );
+
+        // groups and iterators remain valid when particles are appended
+        Group<Tparticle, ParticleVector<Tparticle>::iterator> g(v.begin(), v.end());
+        g.swapDeactivate(g.begin());
+        CHECK( g.size()==3 );
+        CHECK( v.id == std::vector<int>({0,2,3,1}) );
+        v.push_back(p[0]);
+        CHECK( g.trueend()-v.begin() == 4 );
+        CHECK( (g.begin()+1)->id == 2 );
+
+        p = v; // SoA --> std::vector
+        CHECK( p.size()==5 );
+        CHECK( p[0].pos.y() == 1 );
+        CHECK( p[0].charge == 0.5 );
+        CHECK( p[0].mw == 2 );
+        json j = v;
+        CHECK( j.size()==5 );
+        ParticleVector<Tparticle> w = j;
+        CHECK( w.id == v.id );
+    }
+
+    TEST_CASE("[Faunus] Space - structure-of-arrays storage")
+    {
+        typedef Particle<Charge> Tparticle;
+        typedef Space<Geometry::Cuboid, Tparticle, ParticleVector<Tparticle>> Tspace;
+        typedef typename Tspace::Tpvec Tpvec;
+        auto atoms_saved = atoms<Tparticle>;
+        auto molecules_saved = molecules<Tpvec>;
+        atoms<Tparticle> = R"([ {"A": {"q": 1.0}} ])"_json.get<decltype(atoms<Tparticle>)>();
+        molecules<Tpvec> = R"([ {"salt": {"atoms": ["A"], "atomic": true}} ])"_json.get<decltype(molecules<Tpvec>)>();
+
+        Tpvec p(3);
+        p[1].pos.x() = 1;
+        p[2].charge = -1;
+        Tspace spc1, spc2;
+        spc1.geo = R"( {"length": 10} )"_json;
+        spc1.push_back(0, p);
+        spc1.push_back(0, p);
+        CHECK( spc1.p.size()==6 );
+        CHECK( spc1.groups[1].begin()-spc1.p.begin() == 3 );
+        CHECK( &spc1.arrays() == &spc1.p );
+        spc1.updateArrays();
+        CHECK( !spc1.soa.enabled ); // no shadow copy
+
+        Change c;
+        c.all=true;
+        spc2.sync(spc1, c);
+        CHECK( spc2.groups[1].begin()-spc2.p.begin() == 3 );
+        CHECK( spc2.p[5].charge == -1 );
+
+        // charges and single particles
+        spc2.p[5].charge = 1;
+        spc2.p[4].pos.z() = 2;
+        c.clear();
+        Change::data d;
+        d.index = 1;
+        d.charge = true;
+        d.atoms = {2};
+        c.groups.push_back(d);
+        spc1.sync(spc2, c);
+        CHECK( spc1.p[5].charge == 1 );
+        CHECK( spc1.p[4].pos.z() == 0 );
+        c.groups[0].charge = false;
+        c.groups[0].atoms = {1};
+        spc1.sync(spc2, c);
+        CHECK( spc1.p[4].pos.z() == 2 );
+
+        // journal
+        spc1.journal.enabled = true;
+        spc1.journal.clear();
+        spc1.record(0, 1);
+        spc1.p[1].pos.x() = 5;
+        spc1.undo(c);
+        CHECK( spc1.p[1].pos.x() == 1 );
+        spc1.undo(c);
+        CHECK( spc1.p[1].pos.x() == 5 );
+
+        // exchange with vector of particles
+        json j;
+        to_json(j, spc1);
+        CHECK( j["particles"].size()==6 );
+        Tspace spc3 = j;
+        CHECK( spc3.groups.size()==2 );
+        CHECK( spc3.groups[1].begin()-spc3.p.begin() == 3 );
+        CHECK( spc3.p[1].pos.x() == 5 );
+        atoms<Tparticle> = atoms_saved;
+        molecules<Tpvec> = molecules_saved;
+    }
+
     TEST_CASE("[Faunus] Space")
     {
         typedef Particle<Radius, Charge, Dipole, Cigar> Tparticle;
@@ -457,6 +1256,71 @@ namespace Faunus {
         c.groups[0].all=true;
         spc1.sync(spc2, c);
         CHECK( spc1.p.back().pos.z() == doctest::Approx(-0.1) );
+
+        // only charges should be synched
+        spc2.p.back().pos.z()=0.3;
+        spc2.p.back().charge=-0.5;
+        c.groups[0].all=false;
+        c.groups[0].charge=true;
+        c.groups[0].atoms={1};
+        spc1.sync(spc2, c);
+        CHECK( spc1.p.back().charge == doctest::Approx(-0.5) );
+        CHECK( spc1.p.back().pos.z() == doctest::Approx(-0.1) );
+
+        // journal toggles between trial and old state
+        spc1.geo = R"( {"length": 10} )"_json;
+        spc1.journal.enabled=true;
+        c.groups[0].charge=false;
+        spc1.journal.clear();
+        spc1.record(0, 1);
+        spc1.record(0, 1); // recorded only once
+        CHECK( spc1.journal.p.size()==1 );
+        spc1.record(0); // adds remaining particles only
+        CHECK( spc1.journal.p.size()==spc1.groups[0].capacity() );
+        spc1.p[1].pos.x()=4;
+        spc1.groups[0].cm.x()=3;
+        spc1.undo(c);
+        CHECK( spc1.p[1].pos.x() == doctest::Approx(3) );
+        CHECK( spc1.groups[0].cm.x() == doctest::Approx(2.5) );
+        spc1.undo(c);
+        CHECK( spc1.p[1].pos.x() == doctest::Approx(4) );
+        CHECK( spc1.groups[0].cm.x() == doctest::Approx(3) );
+
+        spc1.journal.clear();
+        spc1.recordAll();
+        spc1.geo.setVolume(2000);
+        spc1.groups[0].resize(1);
+        spc1.undo(c);
+        CHECK( spc1.geo.getVolume() == doctest::Approx(1000) );
+        CHECK( spc1.groups[0].size()==2 );
+        spc1.undo(c);
+        CHECK( spc1.geo.getVolume() == doctest::Approx(2000) );
+        CHECK( spc1.groups[0].size()==1 );
+
+        // molecule index by id and activity
+        Random r;
+        spc1.push_back(1, p);
+        CHECK( spc1.moleculeIndex(1, Tspace::ALL) == std::vector<int>({0,1}) );
+        CHECK( spc1.moleculeIndex(1, Tspace::ACTIVE) == std::vector<int>({1}) );
+        CHECK( spc1.moleculeIndex(1, Tspace::INACTIVE) == std::vector<int>({0}) );
+        CHECK( spc1.moleculeIndex(5).empty() );
+        CHECK( spc1.randomMolecule(1, r) == spc1.groups.begin()+1 );
+        CHECK( spc1.randomMolecule(0, r) == spc1.groups.end() );
+        spc1.groups[1].resize(0);
+        spc1.updateMoleculeIndex(1);
+        CHECK( spc1.moleculeIndex(1, Tspace::ACTIVE).empty() );
+        CHECK( spc1.moleculeIndex(1, Tspace::INACTIVE).size()==2 );
+        CHECK( &*spc1.findMolecules(1, Tspace::ALL).begin() == &spc1.groups[0] );
+
+        // particle-to-group table
+        CHECK( spc1.findGroupContaining(spc1.p[0]) == spc1.groups.begin() );
+        CHECK( spc1.findGroupContaining(spc1.p[1]) == spc1.groups.end() ); // inactive
+        spc1.groups[1].activate( spc1.groups[1].inactive().begin(), spc1.groups[1].inactive().end() );
+        CHECK( spc1.findGroupContaining(spc1.p[3]) == spc1.groups.begin()+1 );
+        CHECK( spc1.findGroupContaining(a) == spc1.groups.end() ); // external particle
+        CHECK( spc1.findGroupContaining(size_t(3)) == spc1.groups.begin()+1 );
+        CHECK( spc1.findGroupContaining(spc1.p.size()) == spc1.groups.end() );
+        CHECK( spc1.particlegroup == std::vector<int>({0,0,1,1}) );
     }
 #endif
 
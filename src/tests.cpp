@@ -6,6 +6,7 @@
 #include "random.h"
 #include "core.h"
 #include "mpi.h"
+#include "executor.h"
 #include "auxiliary.h"
 #include "molecule.h"
 #include "group.h"